@@ -166,6 +166,14 @@ namespace openm
         /** write output result table: sub values */
         virtual void writeOutputTable(const char * i_name, size_t i_size, std::forward_list<std::unique_ptr<double[]> > & io_accValues) = 0;
 
+        /** write output result table: sub values stored in a single block, i_stride values apart */
+        virtual void writeOutputTable(const char * i_name, size_t i_size, size_t i_count, size_t i_stride, const double * i_block) = 0;
+
+        /** write output result table: sub values stored in pages, NULL page cells are equal to accumulator fill value */
+        virtual void writeOutputTable(
+            const char * i_name, size_t i_size, size_t i_count, size_t i_pageSize, const double * const * i_pages, const double * i_fill
+            ) = 0;
+
         /** set modeling progress count and value */
         virtual void updateProgress(int i_count, double i_value = 0.0) = 0;
 
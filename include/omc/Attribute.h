@@ -135,6 +135,7 @@ public:
                 handle_prohibited_attribute_assignment(get_name());
             }
         }
+        // the access is counted once, by get()
         T old_value = get();
         if ( old_value != new_value ) {
 
@@ -163,6 +164,9 @@ public:
                 handle_prohibited_timelike_attribute_access(get_name());
             }
         }
+        if constexpr (om_member_profile_on) {
+            ++access_count;
+        }
         return value;
     }
 
@@ -197,6 +201,14 @@ public:
 
 	// offset to containing entity
 	static size_t offset_in_entity;
+
+    /**
+     * Count of accesses to the attribute (if member_profile = on)
+     * 
+     * Accesses of all instances of the attribute in the current member, for member layout by omc.
+     * Reset to zero after the member profile of each member is written.
+     */
+    static thread_local size_t access_count;
 };
 
 /**
@@ -220,6 +232,22 @@ template<
 >
 size_t Attribute<T, T2, A, NT_name, NT_is_time_like, NT_side_effects, NT_se_present, NT_notify, NT_ntfy_present>::offset_in_entity = 0;
 
+/**
+ * Attribute access count (static definition)
+ */
+template<
+    typename T,
+    typename T2,
+    typename A,
+    std::string const *NT_name,
+    bool NT_is_time_like,
+    void (A::*NT_side_effects)(T old_value, T new_value),
+    bool NT_se_present,
+    void (A::*NT_notify)(),
+    bool NT_ntfy_present
+>
+thread_local size_t Attribute<T, T2, A, NT_name, NT_is_time_like, NT_side_effects, NT_se_present, NT_notify, NT_ntfy_present>::access_count = 0;
+
 // Attribute participation in type resolution based on wrapped types
 // by specializing std::common_type.
 // e.g. in min/max/clamp mixed-mode templates
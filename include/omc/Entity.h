@@ -12,7 +12,10 @@
 #include <unordered_set>
 #include <sstream>
 #include <cassert>
+#include <cstring>
 #include "libopenm/omModel.h" // for theTrace
+#include "omc/dense_registry.h"
+#include "omc/slab_allocator.h"
 #include "globals0.h" // for handle_backwards_time
 #include "om_types0.h" // for Time
 
@@ -174,6 +177,20 @@ public:
      */
     virtual void age_entity( Time t ) = 0;
 
+    /**
+     * Add the entity to the list of active entities of its kind (batched_aging = on).
+     * 
+     * Overridden by generated code if the model was built with batched_aging = on.
+     */
+    virtual void om_make_active_kind() {}
+
+    /**
+     * Remove the entity from the list of active entities of its kind (batched_aging = on).
+     * 
+     * Overridden by generated code if the model was built with batched_aging = on.
+     */
+    virtual void om_make_inactive_kind() {}
+
     /**
      * Add the entity to the zombie list for entities of this type.
      */
@@ -204,8 +221,12 @@ public:
      */
     static void age_all_entities( Time t, int originating_entity_id = -1, int originating_event_id = -1)
     {
+        if constexpr (om_batched_aging_on) {
+            age_all_entities_batched(t, originating_entity_id, originating_event_id);
+            return;
+        }
         assert(entities);
-        for ( auto entity : *entities ) {
+        entities->for_each([&](BaseEntity *entity) {
             if (entity->om_get_entity_id() == originating_entity_id) {
                 // This is the entity within which the event occurred.
                 // Check for time running backwards in the entity within which the event occurred
@@ -222,11 +243,24 @@ public:
                 }
             }
             entity->age_entity( t );
-        }
+        });
         // Note that global time is updated in framework module
         // by calling BaseEvent::set_global_time(t);
     }
 
+    /**
+     * Age all entities to the given time, one kind of entity at a time (batched_aging = on).
+     * 
+     * Same as age_all_entities, except that entities are visited by kind, in a loop for each kind
+     * which calls age_entity() of the kind directly rather than through a virtual call.
+     * The function definition is generated by the openM++ compiler.
+     * 
+     * @param t                     The target time.
+     * @param originating_entity_id Identifier of the entity within which the event occurred.
+     * @param originating_event_id  Identifier of the event.
+     */
+    static void age_all_entities_batched(Time t, int originating_entity_id, int originating_event_id);
+
     /**
      * Move all entities from zombie lists to corresponding available list.
      * 
@@ -240,8 +274,10 @@ public:
     void make_active()
     {
         assert(entities);
-        entities->push_front( this );
-        iter_in_entities = entities->begin();
+        entities->insert( this );
+        if constexpr (om_batched_aging_on) {
+            om_make_active_kind();
+        }
     }
 
     /**
@@ -250,7 +286,10 @@ public:
     void make_inactive()
     {
         assert(entities);
-        entities->erase(iter_in_entities);
+        entities->erase( this );
+        if constexpr (om_batched_aging_on) {
+            om_make_inactive_kind();
+        }
     }
 
     /**
@@ -357,14 +396,11 @@ public:
      */
     static void exit_simulation_all()
     {
-        // Iteration over entities needs to be robust to deletion of current iterator.
+        // Iteration over entities is robust to removal of the current entity.
         assert(entities);
-        auto it = entities->begin();
-        while (it != entities->end()) {
-            auto entity = *it;
-            ++it; // increment iterator before erasing it from entities
+        entities->for_each([](BaseEntity *entity) {
             entity->exit_simulation();
-        }
+        });
     }
 
     /**
@@ -1503,14 +1539,16 @@ public:
 private:
 
     /**
-     * The iterator of this entity in BaseEntity::entities.
+     * The position of this entity in BaseEntity::entities.
      */
-    std::list<BaseEntity *>::iterator iter_in_entities;
+    size_t registry_index;
+
+    typedef dense_registry<BaseEntity, &BaseEntity::registry_index> registry_type;
 
     /**
-     * Active entities (polymorphic)
+     * Active entities (polymorphic), most recently activated first
      */
-    static thread_local std::list<BaseEntity *> *entities;
+    static thread_local registry_type *entities;
 };
 
 /**
@@ -1539,7 +1577,14 @@ public:
         }
         assert(available);
         if ( available->empty() ) {
-			entity = ::new E;
+            // storage is adjacent to that of previously allocated entities of this kind
+            assert(slab);
+            void *storage = slab->allocate();
+            if constexpr (om_event_queue_lazy) {
+                // event generations, which are not reset by the event constructor, start at 0
+                std::memset(storage, 0, sizeof(E));
+            }
+			entity = ::new (storage) E;
             if constexpr (om_resource_use_on) {
                 ++allocation_count;
             }
@@ -1552,6 +1597,28 @@ public:
         return entity;
     }
 
+    /**
+     * Entity deallocation operator. Storage belongs to the slab allocator for the entity,
+     * and is released when the simulation runtime is finalized.
+     */
+    void operator delete( void * /*ptr*/ )
+    {
+    }
+
+    /**
+     * Reserve contiguous storage for entities of this kind (capacity hint).
+     * 
+     * Can be called by model code before creating a population, e.g. Person::reserve_entities(StartingPopulationSize).
+     * The next n entities which are not recycled are allocated contiguously in memory.
+     *
+     * @param n Number of entities.
+     */
+    static void reserve_entities( size_t n )
+    {
+        assert(slab);
+        slab->reserve(n);
+    }
+
     void make_zombie()
     {
         assert(zombies);
@@ -1572,7 +1639,9 @@ public:
     }
 
     /**
-     * Free available list and release associated memory.
+     * Free available list and destroy the entities in it.
+     * 
+     * Storage of the entities is released with the slab allocator.
      */
     static void free_available()
     {
@@ -1604,6 +1673,11 @@ public:
     static thread_local std::forward_list<E *> *zombies;
     static thread_local std::forward_list<E *> *available;
 
+    /**
+     * Storage for all entities of this kind
+     */
+    static thread_local slab_allocator<E> *slab;
+
     /**
     * Count of allocations
     *
@@ -1637,6 +1711,13 @@ thread_local std::forward_list<E *> *Entity<E>::zombies;
 template<typename E>
 thread_local std::forward_list<E *> *Entity<E>::available;
 
+/**
+* Entity storage (definition)
+*/
+
+template<typename E>
+thread_local slab_allocator<E> *Entity<E>::slab;
+
 template<typename E>
 thread_local std::size_t Entity<E>::allocation_count = 0;
 
@@ -16,6 +16,7 @@
 	#include <set>
 #endif
 
+#include <vector>
 #include "omc/less_deref.h"
 #include "omc/entity_ptr.h"
 
@@ -29,6 +30,12 @@ struct linkE_comp {
 
 /**
  * An EntitySet.
+ * 
+ * An entity set is ordered by entity_id (or by the attribute in an order clause),
+ * unless it was declared unordered.  The entities of an unordered entity set are stored
+ * in a vector, and each entity stores its position in the vector in a member of the entity,
+ * so that insert, erase, and random access are O(1).  The position of an entity in an
+ * unordered entity set depends only on the sequence of insertions and erasures.
  *
  * @tparam E Entity type.
  */
@@ -39,12 +46,28 @@ class EntitySet
 {
 public:
     EntitySet()
+        : unordered_index(nullptr)
 #if RB_TREE
 #else
-        : is_dirty(true)
+        , is_dirty(true)
 #endif
     {}
 
+    /**
+     * Constructor of an unordered entity set.
+     *
+     * @param index Member of E which stores the position of the entity in the entity set.
+     */
+    explicit EntitySet(int E::* index)
+        : unordered_index(index)
+#if RB_TREE
+#else
+        , is_dirty(true)
+#endif
+    {
+        assert(index);
+    }
+
     ~EntitySet()
     {
 #if RB_TREE
@@ -57,6 +80,9 @@ public:
 	
     size_t size()
     {
+        if (unordered_index) {
+            return unordered_entities.size();
+        }
         return entities.size();
     }
 
@@ -68,6 +94,12 @@ public:
 
     entity_ptr<E> at(size_t index)
     {
+        if (unordered_index) {
+            if (index >= unordered_entities.size()) {
+                return nullptr;
+            }
+            return unordered_entities[index];
+        }
         if (index < 0 || index >= entities.size()) {
             return nullptr;
         }
@@ -96,8 +128,9 @@ public:
 
     entity_ptr<E> GetRandom(double uniform_draw)
     {
-        if (entities.size() > 0) {
-            size_t index = (size_t) (uniform_draw * entities.size());
+        size_t n = size();
+        if (n > 0) {
+            size_t index = (size_t) (uniform_draw * n);
             return at(index);
         }
         else {
@@ -105,12 +138,16 @@ public:
         }
     }
 
-    //TODO: Consider recycling rb_node removed by rb_delete in subsequent rb_insert
-    // in other tree, possibly
+    // Nodes are recycled through a pool shared by all entity sets of entity kind E.
     void insert(E * entity)
     {
+        if (unordered_index) {
+            entity->*unordered_index = (int)unordered_entities.size();
+            unordered_entities.push_back(entity);
+            return;
+        }
 #if RB_TREE
-        auto tmp = new rb_node<entity_ptr<E>>(entity_ptr<E>(entity), entities.NIL);
+        auto tmp = entities.new_node(entity_ptr<E>(entity));
 	    entities.rb_insert(tmp);
 #else
         entities.insert(entity);
@@ -120,11 +157,21 @@ public:
 
     void erase(E * entity)
     {
+        if (unordered_index) {
+            // move the last entity to the position of the erased entity
+            size_t i = entity->*unordered_index;
+            assert(i < unordered_entities.size() && unordered_entities[i] == entity);
+            E * last = unordered_entities.back();
+            unordered_entities[i] = last;
+            last->*unordered_index = (int)i;
+            unordered_entities.pop_back();
+            return;
+        }
 #if RB_TREE
         auto tmp = entities.iterative_tree_search(entity);
         assert(tmp != entities.NIL);
 	    entities.rb_delete(tmp);
-        delete tmp;
+        entities.delete_node(tmp);
 #else
 	    entities.erase(entity);
         is_dirty = true;
@@ -140,6 +187,13 @@ public:
      */
     int rank(const E * entity) const
     {
+        if (unordered_index) {
+            size_t i = entity->*unordered_index;
+            if (i < unordered_entities.size() && unordered_entities[i] == entity) {
+                return (int)i + 1;
+            }
+            return 0; // not found
+        }
 #if RB_TREE
         auto tmp = entities.iterative_tree_search(entity);
         if (tmp == entities.NIL) {
@@ -158,6 +212,12 @@ public:
 
 private:
 
+    //* member of E with the position of the entity in unordered_entities, nullptr if the set is ordered
+    int E::* unordered_index;
+
+    //* storage - entities of an unordered entity set
+    std::vector<E *> unordered_entities;
+
     //* storage - a set of entity links, ordered by entity_id
 #if RB_TREE
     rb_tree<entity_ptr<E>, linkE_comp<E> > entities;
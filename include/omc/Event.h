@@ -8,13 +8,69 @@
 
 #pragma once
 #include <set>
+#include <vector>
+#include <algorithm>
 #include <sstream>
 #include <cassert>
+#include <chrono>
+#include <type_traits>
 #include "omc/less_deref.h"
+#include "omc/indexed_heap.h"
+#include "omc/calendar_queue.h"
+#include "omc/lazy_event_queue.h"
 #include "omc/Entity.h"
 #include "omc/event_priorities.h"
 #include "om_types0.h" // for Time
 
+/**
+ * Accumulated wall-clock time of sampled calls to an event function (resource_use_timing)
+ */
+struct event_function_timing
+{
+    typedef std::chrono::steady_clock clock;
+
+    /**
+     * Whether a call is timed, given the count of calls of the function.
+     */
+    static bool is_sampled(size_t call_count)
+    {
+        return om_resource_use_timing > 0 && call_count % om_resource_use_timing == 0;
+    }
+
+    /**
+     * Record a timed call which started at start.
+     */
+    void add(clock::time_point start)
+    {
+        seconds += std::chrono::duration<double>(clock::now() - start).count();
+        ++samples;
+    }
+
+    /**
+     * Estimated total time in seconds of all calls, given the count of calls.
+     */
+    double estimate(size_t call_count) const
+    {
+        return samples ? seconds * (double)call_count / (double)samples : 0.0;
+    }
+
+    void reset()
+    {
+        samples = 0;
+        seconds = 0.0;
+    }
+
+    /**
+     * Number of timed calls
+     */
+    size_t samples = 0;
+
+    /**
+     * Total time in seconds of timed calls
+     */
+    double seconds = 0.0;
+};
+
 class BaseEvent
 {
 public:
@@ -25,6 +81,11 @@ public:
         in_queue = false;
         is_dirty = false;
         is_zombie = false;
+        if constexpr (!om_event_queue_lazy) {
+            // the generation of a recycled event is kept, tombstones of its previous life may remain in the queue
+            queue_index = 0;
+        }
+        order_key = 0;
     }
 
     // initialization
@@ -42,7 +103,7 @@ public:
         assert(dirty_events);
         if ( ! is_zombie && ! is_dirty ) {
             is_dirty = true;
-            dirty_events->insert( this );
+            dirty_events->push_back( this );
         }
     }
 
@@ -51,10 +112,46 @@ public:
         assert(dirty_events);
         if ( ! is_zombie ) {
             is_zombie = true;
-            dirty_events->insert( this );
+            if ( ! is_dirty ) {
+                // a dirty event is already in the dirty list
+                dirty_events->push_back( this );
+            }
         }
     }
 
+    /**
+     * Pack the components of event ordering into a single key.
+     * 
+     * Events with equal times are ordered by higher event priority,
+     * then by lower event_id, then by lower entity_id.
+     * The packed key has the same ordering using a single unsigned comparison (lower key wins).
+     *
+     * @param event_priority The event priority, in [0,255].
+     * @param event_id       The event_id, in [0,2^24).
+     * @param entity_id      The entity_id.
+     *
+     * @return The packed ordering key.
+     */
+    static uint64_t make_order_key(int event_priority, int event_id, int entity_id)
+    {
+        assert(event_priority >= 0 && event_priority <= 255);
+        assert(event_id >= 0 && event_id < (1 << 24));
+        return ((uint64_t)(255 - event_priority) << 56)
+            | ((uint64_t)event_id << 32)
+            | (uint64_t)((uint32_t)entity_id ^ 0x80000000u); // flip sign bit to preserve signed order
+    }
+
+    /**
+     * Cache the ordering key of this event.
+     * 
+     * Event priority, event_id and entity_id are constant while the entity is in the simulation,
+     * so the key is computed once when the entity enters the simulation.
+     */
+    void initialize_order_key()
+    {
+        order_key = make_order_key(get_event_priority(), get_event_id(), get_entity_id());
+    }
+
     virtual int get_event_id() const = 0;
 
     virtual int get_event_priority() const = 0;
@@ -188,23 +285,8 @@ public:
 		if ( event_time < rhs.event_time ) return true;
 		if ( event_time > rhs.event_time ) return false;
 
-		// higher event priority wins
-		int event_priority = get_event_priority();
-		int rhs_event_priority = rhs.get_event_priority();
-		if ( event_priority > rhs_event_priority ) return true;
-		if ( event_priority < rhs_event_priority ) return false;
-
-		// lower event_id wins (earlier in alphabetic order by event name)
-		int event_id = get_event_id();
-		int rhs_event_id = rhs.get_event_id();
-		if ( event_id < rhs_event_id ) return true;
-		if ( event_id > rhs_event_id ) return false;
-
-		// lower entity_id wins (created earlier)
-		int entity_id = get_entity_id();
-		int rhs_entity_id = rhs.get_entity_id();
-		if ( entity_id < rhs_entity_id ) return true;
-		else return false;
+		// higher event priority wins, then lower event_id, then lower entity_id (see make_order_key)
+		return order_key < rhs.order_key;
     }
 
     /**
@@ -221,23 +303,8 @@ public:
         //if (lhs->event_time < rhs->event_time) return true;
         //if (lhs->event_time > rhs->event_time) return false;
 
-        // higher event priority wins
-        int lhs_event_priority = lhs->get_event_priority();
-        int rhs_event_priority = rhs->get_event_priority();
-        if (lhs_event_priority > rhs_event_priority) return true;
-        if (lhs_event_priority < rhs_event_priority) return false;
-
-        // lower event_id wins (earlier in alphabetic order by event name)
-        int lhs_event_id = lhs->get_event_id();
-        int rhs_event_id = rhs->get_event_id();
-        if (lhs_event_id < rhs_event_id) return true;
-        if (lhs_event_id > rhs_event_id) return false;
-
-        // lower entity_id wins (created earlier)
-        int lhs_entity_id = lhs->get_entity_id();
-        int rhs_entity_id = rhs->get_entity_id();
-        if (lhs_entity_id < rhs_entity_id) return true;
-        else return false;
+        // higher event priority wins, then lower event_id, then lower entity_id (see make_order_key)
+        return lhs->order_key < rhs->order_key;
     }
 
 
@@ -246,8 +313,8 @@ public:
      */
     static void initialize_simulation_runtime()
     {
-        event_queue = new std::set<BaseEvent *, less_deref<BaseEvent *> > ;
-        dirty_events = new std::set<BaseEvent *, decltype(dirty_cmp)*>(dirty_cmp) ;
+        event_queue = new event_queue_type;
+        dirty_events = new std::vector<BaseEvent *>;
         global_time = new Time(0);
         global_event_counter = 0;
         current_event_id = -1;
@@ -291,12 +358,32 @@ public:
             BaseEntity::om_permit_timelike_attribute_access = false;
         }
         assert(dirty_events);
-        auto it = dirty_events->begin();
-        while (it != dirty_events->end()) {
-            auto evt = *it;
-            it = dirty_events->erase(it); // set::erase() returns iterator to next element
+        // Clean dirty events in dirty_cmp order.
+        // The list is sorted once, rather than kept ordered on each insertion.
+        auto& batch = *dirty_events;
+        std::sort(batch.begin(), batch.end(), dirty_cmp);
+        std::vector<BaseEvent *> carry; // events to clean in next call, rarely used
+        size_t n = batch.size();
+        for (size_t i = 0; i < n; ++i) {
+            auto evt = batch[i];
             evt->clean();
+            if (batch.size() > n) {
+                // Cleaning this event made other events dirty,
+                // which is possible only if attribute modification is not verified.
+                // Reproduce the behaviour of iterating an ordered set positioned at the next event:
+                // a new event which follows the next event is cleaned in this pass, in order,
+                // any other new event is cleaned in the next call.
+                auto first_new = batch.begin() + n;
+                std::sort(first_new, batch.end(), dirty_cmp);
+                auto split = (i + 1 < n) ? std::upper_bound(first_new, batch.end(), batch[i + 1], dirty_cmp) : batch.end();
+                carry.insert(carry.end(), first_new, split);
+                batch.erase(first_new, split);
+                std::inplace_merge(batch.begin() + i + 1, batch.begin() + n, batch.end(), dirty_cmp);
+                n = batch.size();
+            }
         }
+        // retain storage of the dirty list for reuse
+        batch.assign(carry.begin(), carry.end());
         if (om_verify_attribute_modification) { // is constexpr
             // permit attribute assignment after recomputation of dirty event times is complete
             BaseEntity::om_permit_attribute_modification = true;
@@ -439,6 +526,11 @@ public:
      */
     Time event_time;
 
+    /**
+     * Cached ordering key of event for equal event times (see make_order_key).
+     */
+    uint64_t order_key;
+
     /**
      * Storage for memory events.
      */
@@ -459,20 +551,51 @@ public:
      */
     bool is_zombie : 1;
 
+    /**
+     * Position of event in \a event_queue.
+     * 
+     * Maintained by the event queue if it is an indexed_heap or calendar_queue.
+     * If it is a lazy_event_queue, this is instead the generation of the event,
+     * which is incremented when the event is removed.  The generation is not reset by the constructor
+     * when an entity is recycled, and starts at 0 in storage newly obtained for an entity.
+     */
+    uint32_t queue_index;
+
+    /**
+     * Type of the event queue.
+     * 
+     * Selected by the model option event_queue (set, heap, calendar, or lazy).
+     * All implementations order events identically using BaseEvent::operator<.
+     */
+    typedef std::conditional_t<
+        om_event_queue_heap,
+        indexed_heap<BaseEvent *, less_deref<BaseEvent *> >,
+        std::conditional_t<
+            om_event_queue_calendar,
+            calendar_queue<BaseEvent *, less_deref<BaseEvent *> >,
+            std::conditional_t<
+                om_event_queue_lazy,
+                lazy_event_queue<BaseEvent *>,
+                std::set<BaseEvent *, less_deref<BaseEvent *> >
+            >
+        >
+    > event_queue_type;
+
     /**
      * The event queue (declaration)
      * 
      * Defined by C++ code generated by omc.
      */
-    static thread_local std::set<BaseEvent *, less_deref<BaseEvent *> > *event_queue;
+    static thread_local event_queue_type *event_queue;
 
     /**
      * The dirty event list (declaration)
      * Contains events whose times require calculation.
+     * Events are appended unordered, and sorted by dirty_cmp in clean_all().
      * 
      * Defined by C++ code generated by omc.
      */
-    static thread_local std::set<BaseEvent*, decltype(dirty_cmp)* > *dirty_events;
+    static thread_local std::vector<BaseEvent *> *dirty_events;
 
     /**
      * The event_id of the current event
@@ -650,7 +773,19 @@ public:
         (entity()->om_lifecycle_event)(get_event_id());
         // Note that implement_function is not a class member.
         // It is a compile-time constant supplied as a template argument.
-        (entity()->*implement_function)();
+        if constexpr (om_resource_use_timing > 0) {
+            if (event_function_timing::is_sampled(occurrence_count)) {
+                auto start = event_function_timing::clock::now();
+                (entity()->*implement_function)();
+                implement_func_timing.add(start);
+            }
+            else {
+                (entity()->*implement_function)();
+            }
+        }
+        else {
+            (entity()->*implement_function)();
+        }
         if constexpr (om_resource_use_on) {
             ++occurrence_count;
         }
@@ -666,6 +801,14 @@ public:
         if constexpr (om_resource_use_on) {
             ++calculation_count;
         }
+        if constexpr (om_resource_use_timing > 0) {
+            if (event_function_timing::is_sampled(calculation_count)) {
+                auto start = event_function_timing::clock::now();
+                Time t = (entity()->*time_function)();
+                time_func_timing.add(start);
+                return t;
+            }
+        }
         return (entity()->*time_function)();
     }
 
@@ -707,8 +850,12 @@ public:
      */
     static auto resource_use()
     {
-        struct result { size_t max_in_queue;  size_t time_calculations; size_t censored_times; size_t occurrences; };
-        return result { queue_count_max, calculation_count, censor_count, occurrence_count };
+        struct result { size_t max_in_queue;  size_t time_calculations; size_t censored_times; size_t occurrences; double time_func_seconds; double implement_func_seconds; size_t time_func_samples; size_t implement_func_samples; };
+        return result {
+            queue_count_max, calculation_count, censor_count, occurrence_count,
+            time_func_timing.estimate(calculation_count), implement_func_timing.estimate(occurrence_count),
+            time_func_timing.samples, implement_func_timing.samples
+        };
     }
 
     /**
@@ -721,6 +868,8 @@ public:
         calculation_count = 0;
         censor_count = 0;
         occurrence_count = 0;
+        time_func_timing.reset();
+        implement_func_timing.reset();
     }
 
     // offset to containing entity
@@ -761,6 +910,20 @@ public:
     * Right-censored events will not occur, so are not entered in the event queue.
     */
     static thread_local size_t censor_count;
+
+    /**
+    * Timing of the time function
+    *
+    * Sampled calls of the time function, if resource_use_timing is on.
+    */
+    static thread_local event_function_timing time_func_timing;
+
+    /**
+    * Timing of the implement function
+    *
+    * Sampled calls of the implement function, if resource_use_timing is on.
+    */
+    static thread_local event_function_timing implement_func_timing;
 };
 
 template<typename A, const int event_id, const int event_priority, const int modgen_event_num, void (A::* implement_function)(), Time(A::* time_function)()>
@@ -781,6 +944,12 @@ thread_local size_t Event<A, event_id, event_priority, modgen_event_num, impleme
 template<typename A, const int event_id, const int event_priority, const int modgen_event_num, void (A::* implement_function)(), Time(A::* time_function)()>
 thread_local size_t Event<A, event_id, event_priority, modgen_event_num, implement_function, time_function>::censor_count = 0;
 
+template<typename A, const int event_id, const int event_priority, const int modgen_event_num, void (A::* implement_function)(), Time(A::* time_function)()>
+thread_local event_function_timing Event<A, event_id, event_priority, modgen_event_num, implement_function, time_function>::time_func_timing;
+
+template<typename A, const int event_id, const int event_priority, const int modgen_event_num, void (A::* implement_function)(), Time(A::* time_function)()>
+thread_local event_function_timing Event<A, event_id, event_priority, modgen_event_num, implement_function, time_function>::implement_func_timing;
+
 
 /**
  * A memory event, within a given kind of entity
@@ -838,7 +1007,19 @@ public:
     {
         // Note that implement_function is not a class member.
         // It is a compile-time constant supplied as a template argument.
-        (entity()->*implement_function)(memory);
+        if constexpr (om_resource_use_timing > 0) {
+            if (event_function_timing::is_sampled(occurrence_count)) {
+                auto start = event_function_timing::clock::now();
+                (entity()->*implement_function)(memory);
+                implement_func_timing.add(start);
+            }
+            else {
+                (entity()->*implement_function)(memory);
+            }
+        }
+        else {
+            (entity()->*implement_function)(memory);
+        }
         if constexpr (om_resource_use_on) {
             ++occurrence_count;
         }
@@ -856,7 +1037,20 @@ public:
             ++calculation_count;
         }
         // use staging area memory_staging for model to communicate int 'event memory' value
-        Time t = (entity()->*time_function)(&memory_staging);
+        Time t;
+        if constexpr (om_resource_use_timing > 0) {
+            if (event_function_timing::is_sampled(calculation_count)) {
+                auto start = event_function_timing::clock::now();
+                t = (entity()->*time_function)(&memory_staging);
+                time_func_timing.add(start);
+            }
+            else {
+                t = (entity()->*time_function)(&memory_staging);
+            }
+        }
+        else {
+            t = (entity()->*time_function)(&memory_staging);
+        }
         if (memory_staging < std::numeric_limits<uint16_t>::min() || memory_staging > std::numeric_limits<uint16_t>::max()) {
             // The supplied 'event memory' value is not within the limits of uint16_s
             std::stringstream ss;
@@ -910,8 +1104,12 @@ public:
      */
     static auto resource_use()
     {
-        struct result { size_t max_in_queue;  size_t time_calculations; size_t censored_times; size_t occurrences; };
-        return result { queue_count_max, calculation_count, censor_count, occurrence_count };
+        struct result { size_t max_in_queue;  size_t time_calculations; size_t censored_times; size_t occurrences; double time_func_seconds; double implement_func_seconds; size_t time_func_samples; size_t implement_func_samples; };
+        return result {
+            queue_count_max, calculation_count, censor_count, occurrence_count,
+            time_func_timing.estimate(calculation_count), implement_func_timing.estimate(occurrence_count),
+            time_func_timing.samples, implement_func_timing.samples
+        };
     }
 
     /**
@@ -924,6 +1122,8 @@ public:
         calculation_count = 0;
         censor_count = 0;
         occurrence_count = 0;
+        time_func_timing.reset();
+        implement_func_timing.reset();
     }
 
     // offset to containing entity
@@ -964,6 +1164,20 @@ public:
     * Right-censored events will not occur, so are not entered in the event queue.
     */
     static thread_local size_t censor_count;
+
+    /**
+    * Timing of the time function
+    *
+    * Sampled calls of the time function, if resource_use_timing is on.
+    */
+    static thread_local event_function_timing time_func_timing;
+
+    /**
+    * Timing of the implement function
+    *
+    * Sampled calls of the implement function, if resource_use_timing is on.
+    */
+    static thread_local event_function_timing implement_func_timing;
 };
 
 template<typename A, const int event_id, const int event_priority, const int modgen_event_num, void (A::*implement_function)(int), Time(A::*time_function)(int *)>
@@ -983,3 +1197,9 @@ thread_local size_t MemoryEvent<A, event_id, event_priority, modgen_event_num, i
 
 template<typename A, const int event_id, const int event_priority, const int modgen_event_num, void (A::* implement_function)(int), Time(A::* time_function)(int*)>
 thread_local size_t MemoryEvent<A, event_id, event_priority, modgen_event_num, implement_function, time_function>::censor_count = 0;
+
+template<typename A, const int event_id, const int event_priority, const int modgen_event_num, void (A::* implement_function)(int), Time(A::* time_function)(int*)>
+thread_local event_function_timing MemoryEvent<A, event_id, event_priority, modgen_event_num, implement_function, time_function>::time_func_timing;
+
+template<typename A, const int event_id, const int event_priority, const int modgen_event_num, void (A::* implement_function)(int), Time(A::* time_function)(int*)>
+thread_local event_function_timing MemoryEvent<A, event_id, event_priority, modgen_event_num, implement_function, time_function>::implement_func_timing;
@@ -8,12 +8,20 @@
 
 #pragma once
 
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <memory>
 #include "entity_ptr.h"
 
 
 namespace omr {
     /// The multilink size warning threshold
     constexpr size_t multilink_size_warning_threshold = 1000;
+
+    /// The multilink size above which an index of slots is maintained
+    constexpr size_t multilink_index_threshold = 32;
 }
 
 /**
@@ -21,6 +29,13 @@ namespace omr {
  * 
  * A multilink is a set of links which form one side of a one-to-many or many-to-mnay
  * link among entities.
+ * 
+ * Links are stored in a vector of slots.  An erased link leaves an empty slot (a hole),
+ * which is filled by the next inserted link, lowest slot first.  Slots are never moved,
+ * so iteration order and slot positions are not affected by erasures.
+ * The number of links is maintained.  Once a multilink has more than
+ * omr::multilink_index_threshold slots, an index from entity to slot and a heap of holes
+ * are maintained, so that insert and erase do not search the slots.
  *
  * @tparam T            Type of the link in the collection, e.g. link<Thing>
  * @tparam A            Type of containing entity, e.g. Person
@@ -34,6 +49,7 @@ public:
 
     // ctor
     explicit Multilink()
+        : live(0)
     {
     }
 
@@ -52,10 +68,10 @@ public:
     // standard member functions for std::set containers
     void clear()
     {
-        for (auto &item : storage) {
-            auto lnk = item.get();
+        for (size_t slot = 0; slot < storage.size(); ++slot) {
+            auto lnk = storage[slot].get();
             if (lnk != nullptr) {
-                item = nullptr;
+                vacate(slot);
                 // maintain reciprocal link
                 (entity()->*erase_reciprocal)(lnk);
             }
@@ -66,37 +82,34 @@ public:
 
     size_t size()
     {
-        size_t non_empty = 0;
-        for (auto &item : storage) {
-            if (item.get() != nullptr) ++non_empty;
-        }
-        return non_empty;
+        return live;
     }
 
     void insert(entity_ptr<B> lnk)
     {
-        bool found = false;
-        entity_ptr<B> *hole = nullptr; // pointer to the first hole in the vector, if there is one
-
-	    for (auto &item : storage) {
-		    if (item  == lnk) {
-			    found = true;
-			    break;
-		    }
-		    if (item.get() == nullptr && hole == nullptr) {
-                // save pointer to the first hole in the vector
-			    hole = &item;
-		    }
-	    }
-	    if ( !found ) {
+        if (lnk.get() == nullptr || find_slot(lnk.get()) != no_slot) {
+            // nothing to insert, or already present
+            return;
+        }
+        {
             // element not found, so add it.
-		    if ( hole != nullptr ) {
+            size_t hole = take_hole();
+		    if ( hole != no_slot ) {
                 // found a hole in the vector, store the new element there
-			    *hole = lnk;
+			    storage[hole] = lnk;
+                if (index) {
+                    index->slot_of[lnk.get()] = hole;
+                }
 		    }
 		    else {
                 // append the new element to the end of the array
 			    storage.push_back(lnk);
+                if (index) {
+                    index->slot_of[lnk.get()] = storage.size() - 1;
+                }
+                else if (storage.size() > omr::multilink_index_threshold) {
+                    build_index();
+                }
                 if (!multilink_size_warning_issued) {
                     if (omr::multilink_size_warning_threshold < storage.size()) {
                         theLog->logFormatted(LT("warning : A multilink has grown larger than %d - possible performance impact"), omr::multilink_size_warning_threshold);
@@ -111,6 +124,7 @@ public:
                     }
                 }
             }
+            ++live;
     		// process side-effects
             (entity()->*side_effects)();
             // maintain reciprocal link
@@ -120,15 +134,16 @@ public:
 
     void erase(entity_ptr<B> lnk)
     {
-        for (auto &item : storage) {
-            if (item == lnk) {
-                item = nullptr;
-    		    // process side-effects
-                (entity()->*side_effects)();
-                // maintain reciprocal link
-                (entity()->*erase_reciprocal)(lnk);
-                break;
-            }
+        if (lnk.get() == nullptr) {
+            return;
+        }
+        size_t slot = find_slot(lnk.get());
+        if (slot != no_slot) {
+            vacate(slot);
+    	    // process side-effects
+            (entity()->*side_effects)();
+            // maintain reciprocal link
+            (entity()->*erase_reciprocal)(lnk);
         }
     }
 
@@ -205,11 +220,14 @@ public:
 
     void FinishAll()
     {
-        for (auto &item : storage) {
-            auto lnk = item.get();
+        for (size_t slot = 0; slot < storage.size(); ++slot) {
+            auto lnk = storage[slot].get();
             if (lnk != nullptr) {
-                item->Finish();
-                item = nullptr;
+                lnk->Finish();
+                // Finish may already have erased the link
+                if (storage[slot].get() != nullptr) {
+                    vacate(slot);
+                }
             }
         }
 		// process side-effects
@@ -221,6 +239,117 @@ public:
     // storage
     std::vector<entity_ptr<B>> storage;
 
+private:
+    /**
+     * Value of a slot position indicating no slot.
+     */
+    static constexpr size_t no_slot = (size_t)-1;
+
+    /**
+     * Index of a large multilink.
+     */
+    struct slot_index {
+        /**
+         * Slot of each entity in the multilink.
+         */
+        std::unordered_map<B *, size_t> slot_of;
+
+        /**
+         * Holes, as a min-heap of slot positions.
+         */
+        std::vector<size_t> holes;
+    };
+
+    /**
+     * Slot of an entity in the multilink, or no_slot if not present.
+     */
+    size_t find_slot(B * ent) const
+    {
+        if (index) {
+            auto it = index->slot_of.find(ent);
+            return (it == index->slot_of.end()) ? no_slot : it->second;
+        }
+        for (size_t slot = 0; slot < storage.size(); ++slot) {
+            if (storage[slot].get() == ent) {
+                return slot;
+            }
+        }
+        return no_slot;
+    }
+
+    /**
+     * Remove and return the lowest hole, or no_slot if there are no holes.
+     */
+    size_t take_hole()
+    {
+        if (live == storage.size()) {
+            // no holes
+            return no_slot;
+        }
+        if (index) {
+            auto& holes = index->holes;
+            assert(!holes.empty());
+            std::pop_heap(holes.begin(), holes.end(), std::greater<size_t>());
+            size_t slot = holes.back();
+            holes.pop_back();
+            assert(slot < storage.size() && storage[slot].get() == nullptr);
+            return slot;
+        }
+        for (size_t slot = 0; slot < storage.size(); ++slot) {
+            if (storage[slot].get() == nullptr) {
+                return slot;
+            }
+        }
+        assert(false); // logic guarantee
+        return no_slot;
+    }
+
+    /**
+     * Empty a slot, making it a hole.
+     */
+    void vacate(size_t slot)
+    {
+        assert(slot < storage.size() && storage[slot].get() != nullptr);
+        if (index) {
+            index->slot_of.erase(storage[slot].get());
+            index->holes.push_back(slot);
+            std::push_heap(index->holes.begin(), index->holes.end(), std::greater<size_t>());
+        }
+        storage[slot] = nullptr;
+        --live;
+    }
+
+    /**
+     * Create the index from the slots.
+     */
+    void build_index()
+    {
+        index.reset(new slot_index);
+        for (size_t slot = 0; slot < storage.size(); ++slot) {
+            auto ent = storage[slot].get();
+            if (ent != nullptr) {
+                index->slot_of[ent] = slot;
+            }
+            else {
+                index->holes.push_back(slot);
+            }
+        }
+        // slots were visited in ascending order, so holes is a min-heap
+        assert(std::is_heap(index->holes.begin(), index->holes.end(), std::greater<size_t>()));
+    }
+
+    /**
+     * Number of links (slots which are not holes).
+     */
+    size_t live;
+
+    /**
+     * Index of slots, present only if the multilink has more than omr::multilink_index_threshold slots.
+     */
+    std::unique_ptr<slot_index> index;
+
+public:
+
     /**
      * Resource use information for the multilink
      */
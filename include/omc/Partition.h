@@ -20,8 +20,7 @@
     * @tparam T     Storage type for partition value (interval, 0-based).  Must fall within limits of int.
     * @tparam T_size Number of intervals in partition
     * @tparam T_lower  Array containing lower limit of each interval in the partition.
-    * @tparam T_upper  Array containing upper limit of each interval in the partition.
-    * @tparam T_set Set used by find_interval to find the interval for a given number.
+    * @tparam T_upper  Array containing upper limit of each interval in the partition (constexpr).
     * @tparam NT_name Name of the range (non-type argument).
     */
 
@@ -30,7 +29,6 @@ template<
     T T_size,
     const std::array<real, T_size> &T_lower,
     const std::array<real, T_size> &T_upper,
-    const std::map<real, T> &T_splitter,
     std::string const* NT_name
 >
 class Partition
@@ -179,9 +177,29 @@ public:
     // Find the interval within which a value falls.
     static int value_to_interval(real value)
     {
-        // find first interval whose upper bound exceeds value
-        auto it = T_splitter.upper_bound(value);
-        return (it == T_splitter.end()) ? max : it->second;
+        // the interval is the number of split points which do not exceed value,
+        // i.e. the first interval whose upper bound exceeds value, or max if none (or if value is NaN)
+        constexpr real uniform_width = find_uniform_width();
+        if constexpr (uniform_width > 0) {
+            // equally spaced split points: direct bucket, then correct rounding by at most one interval
+            real q = (value - T_upper[0]) / uniform_width + 1;
+            int i = (q >= 1) ? ((q < max) ? (int)q : max) : ((q < 1) ? 0 : max);
+            i -= (int)(i > 0 && value < T_upper[i - 1]);
+            i += (int)(i < max && !(value < T_upper[i]));
+            return i;
+        }
+        else {
+            // branchless binary search over split points, unrolled for the fixed number of split points
+            const real * base = T_upper.data();
+            size_t n = T_size - 1;
+            if (n == 0) return 0;
+            while (n > 1) {
+                size_t half = n / 2;
+                base = (value < base[half]) ? base : base + half;
+                n -= half;
+            }
+            return (int)(base - T_upper.data()) + (int)!(value < *base);
+        }
     }
 
     // Find the interval within which a value falls (overload for int)
@@ -240,6 +258,23 @@ private:
         return interval = (T)trunced_interval;
     }
 
+    /**
+     * Width of intervals if the split points are equally spaced, otherwise 0.
+     *
+     * Evaluated at compile time from the partition bounds.
+     */
+    static constexpr real find_uniform_width()
+    {
+        // at least 2 split points between bounded intervals
+        if (T_size < 3) return 0;
+        real w = T_upper[1] - T_upper[0];
+        if (!(w > 0)) return 0;
+        for (size_t i = 2; i + 1 < (size_t)T_size; ++i) {
+            if (T_upper[i] - T_upper[i - 1] != w) return 0;
+        }
+        return w;
+    }
+
     // storage - the interval in the partition (0-based)
     T interval;
 };
@@ -252,30 +287,27 @@ template<
     T T_size,
     const std::array<real, T_size> &T_lower,
     const std::array<real, T_size> &T_upper,
-    const std::map<real, T> &T_splitter,
     std::string const* NT_name
 >
-const T Partition<T, T_size, T_lower, T_upper, T_splitter, NT_name>::min = 0;
+const T Partition<T, T_size, T_lower, T_upper, NT_name>::min = 0;
 
 template<
     typename T,
     T T_size,
     const std::array<real, T_size> &T_lower,
     const std::array<real, T_size> &T_upper,
-    const std::map<real, T> &T_splitter,
     std::string const* NT_name
 >
-const T Partition<T, T_size, T_lower, T_upper, T_splitter, NT_name>::max = T_size - 1;
+const T Partition<T, T_size, T_lower, T_upper, NT_name>::max = T_size - 1;
 
 template<
     typename T,
     T T_size,
     const std::array<real, T_size> &T_lower,
     const std::array<real, T_size> &T_upper,
-    const std::map<real, T> &T_splitter,
     std::string const* NT_name
 >
-const int Partition<T, T_size, T_lower, T_upper, T_splitter, NT_name>::size = T_size;
+const int Partition<T, T_size, T_lower, T_upper, NT_name>::size = T_size;
 #else // defined(_MSC_VER)
     // MSVC bug workaround 2020-07-03
     // With standard idiom, MSVC does not treat these as compile time constants.
@@ -7,12 +7,113 @@
 // This code is licensed under the MIT license (see LICENSE.txt)
 
 #pragma once
+#include <cassert>
 #include <vector>
 #include <map>
 #include <algorithm>
 #include <numeric>
 #include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
+#include <forward_list>
+#include <cmath>
+#include "omc/quantile_sketch.h"
+#include "omc/extrema_heap.h"
+#include "omc/paged_cells.h"
+
+/**
+ * Storage of an observation collection in a cell of an entity table.
+ *
+ * A bounded-memory quantile sketch if the model was built with a quantile_sketch option,
+ * otherwise a contiguous buffer of all observations.
+ */
+using obs_collection_type = std::conditional_t<om_quantile_sketch_on, quantile_sketch<om_quantile_sketch_k>, std::vector<double>>;
+
+/**
+ * Storage of N values of type T in each of Tcells cells of an entity table.
+ *
+ * Takes no storage if N is 0.
+ */
+template<typename T, int N, int Tcells>
+using per_cell_array = std::array<std::array<T, N>, (N > 0 ? Tcells : 0)>;
+
+/**
+ * Storage of N values of type T in each of Tcells cells of an entity table,
+ * allocated in pages on first touch if Tpaged.
+ */
+template<typename T, int N, int Tcells, bool Tpaged>
+using per_cell_storage = std::conditional_t<Tpaged, paged_cell_arrays<T, N, Tcells>, per_cell_array<T, N, Tcells>>;
+
+/**
+ * Position of percentile p in n sorted observations.
+ *
+ * The percentile is the first observation at which the cumulative count reaches n * p.
+ *
+ * @return The zero-based position of the percentile.
+ */
+inline size_t obs_collection_position(size_t n, double p)
+{
+    assert(n > 0);
+    size_t r = (size_t)std::ceil((double)n * p);
+    return std::clamp<size_t>(r, 1, n) - 1;
+}
+
+/**
+ * Gini coefficient of n sorted observations.
+ */
+inline double obs_collection_gini(const double* x, size_t n)
+{
+    double cum_value = 0.0;
+    double cum_value_i = 0.0; // sum of rank*value
+    for (size_t i = 0; i < n; ++i) {
+        cum_value += x[i];
+        cum_value_i += (double)(i + 1) * x[i];
+    }
+    double total_count = (double)n;
+    return (2.0 * cum_value_i) / (total_count * cum_value) - (total_count + 1.0) / total_count;
+}
+
+/**
+ * Alignment in bytes of table storage blocks, the size of a cache line.
+ */
+constexpr size_t table_block_alignment = 64;
+
+/**
+ * Deleter of a table storage block.
+ */
+struct table_block_deleter
+{
+    void operator()(double* p) const
+    {
+        ::operator delete[](p, std::align_val_t(table_block_alignment));
+    }
+};
+
+/**
+ * A table storage block, holding arrays of cell values contiguously.
+ */
+typedef std::unique_ptr<double[], table_block_deleter> table_block;
+
+/**
+ * Number of doubles between consecutive arrays of cell values in a table storage block.
+ *
+ * Each array starts on a cache line.
+ */
+constexpr size_t table_block_stride(size_t cells)
+{
+    const size_t per_line = table_block_alignment / sizeof(double);
+    return (cells + per_line - 1) / per_line * per_line;
+}
+
+/**
+ * Allocate a table storage block for the given number of arrays of cell values.
+ */
+inline table_block new_table_block(size_t arrays, size_t cells)
+{
+    size_t n = arrays * table_block_stride(cells);
+    return table_block(static_cast<double*>(::operator new[](n * sizeof(double), std::align_val_t(table_block_alignment))));
+}
 
 /**
  * A table.
@@ -20,11 +121,17 @@
  * @tparam Tdimensions Number of dimensions.
  * @tparam Tcells      Number of cells.
  * @tparam Tmeasures   Number of measures.
+ * @tparam Tpaged      Cell values are allocated in pages on first touch (sparse table).
  */
-template<int Tdimensions, int Tcells, int Tmeasures>
+template<int Tdimensions, int Tcells, int Tmeasures, bool Tpaged = false>
 class Table
 {
 public:
+    /**
+     * Storage of the values of a measure or accumulator in all cells.
+     */
+    typedef std::conditional_t<Tpaged, paged_cells<Tcells>, double *> cells_type;
+
     Table(const char *name, std::initializer_list<int> shape)
         : name(name)
         , shape(shape)
@@ -38,11 +145,12 @@ public:
         // The number of cells is equal to product of the values in shape.
         assert(n_cells == std::accumulate(shape.begin(), shape.end(), 1, std::multiplies<int>()));
 
-        // allocate and initialize measures
-        auto it = measure_storage.before_begin();
-        for (int msr = 0; msr < n_measures; ++msr) {
-            it = measure_storage.insert_after(it, std::unique_ptr<double[]>(new double[Tcells]));
-            measure[msr] = it->get();
+        if constexpr (!Tpaged) {
+            // allocate and initialize measures, in a single block with each measure on a cache line
+            measure_block = new_table_block(Tmeasures, Tcells);
+            for (int msr = 0; msr < n_measures; ++msr) {
+                measure[msr] = measure_block.get() + msr * cell_stride;
+            }
         }
 
         initialize_measures();
@@ -54,8 +162,13 @@ public:
     void initialize_measures()
     {
         for (int msr = 0; msr < n_measures; ++msr) {
-            for (int cell = 0; cell < n_cells; ++cell) {
-                measure[msr][cell] = std::numeric_limits<double>::quiet_NaN();
+            if constexpr (Tpaged) {
+                measure[msr].reset(std::numeric_limits<double>::quiet_NaN());
+            }
+            else {
+                for (int cell = 0; cell < n_cells; ++cell) {
+                    measure[msr][cell] = std::numeric_limits<double>::quiet_NaN();
+                }
             }
         }
     }
@@ -145,6 +258,11 @@ public:
      */
     static const int n_measures = Tmeasures;
 
+    /**
+     * The number of doubles from a measure or accumulator to the next in table storage.
+     */
+    static constexpr size_t cell_stride = table_block_stride(Tcells);
+
     /**
      * The name of the table.
      */
@@ -158,8 +276,8 @@ public:
     /**
      * Measure storage.
      */
-    double * measure[Tmeasures];            // measure[Tmeasures][Tcells];
-    std::forward_list<std::unique_ptr<double[]> > measure_storage;
+    cells_type measure[Tmeasures];          // measure[Tmeasures][Tcells];
+    table_block measure_block;              // measure[k] is at offset k * cell_stride, unless Tpaged
 };
 
 /**
@@ -174,35 +292,49 @@ public:
  * @tparam Tcollections  Number of observation collections in each cell (possibly 0).
  * @tparam Textras  Number of extra doubles in each cell (possibly 0).
  * @tparam Textremas  Number of extrema pairs of collections in each cell (possibly 0).
+ * @tparam Tpaged  Accumulators, counts, sums of weights, measures, observation collections, extras,
+ *                 and extremas are allocated in pages on first touch.
  */
-template<int Tdimensions, int Tcells, int Tmeasures, int Taccumulators, bool Thas_count, bool Thas_sumweight, int Tcollections, int Textras, int Textremas>
-class EntityTable : public Table<Tdimensions, Tcells, Tmeasures>
+template<int Tdimensions, int Tcells, int Tmeasures, int Taccumulators, bool Thas_count, bool Thas_sumweight, int Tcollections, int Textras, int Textremas, bool Tpaged = false>
+class EntityTable : public Table<Tdimensions, Tcells, Tmeasures, Tpaged>
 {
 public:
-    EntityTable(const char* name, std::initializer_list<int> shape) : Table<Tdimensions, Tcells, Tmeasures>(name, shape)
+    typedef typename Table<Tdimensions, Tcells, Tmeasures, Tpaged>::cells_type cells_type;
+
+    /**
+     * Storage of count or sum of weights in all cells.
+     */
+    typedef std::conditional_t<Tpaged, paged_cells<Tcells>, double *> count_type;
+
+    EntityTable(const char* name, std::initializer_list<int> shape) : Table<Tdimensions, Tcells, Tmeasures, Tpaged>(name, shape)
     {
-        {
-            // accumulator storage is allocated here, but initialized by member function initialize_accumulators().
-            auto it = acc_storage.before_begin();
-            for (int k = 0; k < Taccumulators; k++) {
-                it = acc_storage.insert_after(it, std::unique_ptr<double[]>(new double[Tcells]));
-                acc[k] = it->get();
+        if constexpr (!Tpaged) {
+            {
+                // accumulator storage is allocated here, but initialized by member function initialize_accumulators().
+                // in a single block, with each accumulator on a cache line, followed by count and sumweight
+                acc_block = new_table_block(Taccumulators + (has_count ? 1 : 0) + (has_sumweight ? 1 : 0), Tcells);
+                for (int k = 0; k < Taccumulators; k++) {
+                    acc[k] = acc_block.get() + k * this->cell_stride;
+                }
             }
-        }
-        if (has_count) {
-            // count storage is allocated here, and initialized to 0.0 for all cells.
-            count = std::unique_ptr<double[]>(new double[Tcells]);
-            for (int j = 0; j < Tcells; ++j) {
-                count[j] = 0.0;
+            size_t row = Taccumulators;
+            if (has_count) {
+                // count storage is in the accumulator block, and initialized to 0.0 for all cells.
+                count = acc_block.get() + row++ * this->cell_stride;
+                for (int j = 0; j < Tcells; ++j) {
+                    count[j] = 0.0;
+                }
             }
-        }
-        if (has_sumweight) {
-            // sumweight storage is allocated here, and initialized to 0.0 for all cells.
-            sumweight = std::unique_ptr<double[]>(new double[Tcells]);
-            for (int j = 0; j < Tcells; ++j) {
-                sumweight[j] = 0.0;
+            if (has_sumweight) {
+                // sumweight storage is in the accumulator block, and initialized to 0.0 for all cells.
+                sumweight = acc_block.get() + row++ * this->cell_stride;
+                for (int j = 0; j < Tcells; ++j) {
+                    sumweight[j] = 0.0;
+                }
             }
         }
+        // else pages of accumulators, count, sumweight, collections, extras and extremas are allocated on first touch,
+        // count and sumweight are 0.0.
     };
 
     virtual void initialize_accumulators() = 0;
@@ -210,11 +342,318 @@ public:
     virtual void scale_accumulators() = 0;
     virtual void compute_expressions() = 0;
 
+    /**
+     * Indicates if a cell in page p of any accumulator, count, sum of weights, observation collection,
+     * extra or extrema was touched, for a paged table.
+     */
+    bool page_touched(size_t p) const
+    {
+        bool touched = false;
+        for (int k = 0; k < Taccumulators; k++) {
+            touched = touched || acc[k].page(p);
+        }
+        if (has_count) {
+            touched = touched || count.page(p);
+        }
+        if (has_sumweight) {
+            touched = touched || sumweight.page(p);
+        }
+        if constexpr (Tcollections > 0) {
+            touched = touched || coll.page(p);
+        }
+        if constexpr (Textras > 0) {
+            touched = touched || extra.page(p);
+        }
+        if constexpr (Textremas > 0) {
+            touched = touched || extrema.page(p);
+        }
+        return touched;
+    }
+
+    /**
+     * Call f for each cell which may have been touched since accumulators were initialized.
+     *
+     * For a paged table, these are the cells in pages allocated for any accumulator, count, sum of weights,
+     * observation collection, extra or extrema, otherwise all cells.
+     */
+    template<typename F>
+    void for_each_touched_cell(F f)
+    {
+        if constexpr (Tpaged) {
+            const size_t page_size = paged_cells<Tcells>::page_size;
+            for (size_t p = 0; p < paged_cells<Tcells>::n_pages; ++p) {
+                if (page_touched(p)) {
+                    size_t end = std::min<size_t>(Tcells, (p + 1) * page_size);
+                    for (size_t cell = p * page_size; cell < end; ++cell) {
+                        f((int)cell);
+                    }
+                }
+            }
+        }
+        else {
+            for (int cell = 0; cell < Tcells; ++cell) {
+                f(cell);
+            }
+        }
+    }
+
+    /**
+     * Call f for the cells never touched, for a paged table.
+     *
+     * The cells never touched have identical accumulators, counts and sums of weights, and empty
+     * collections and extremas, so f gives identical results for each of them.  f is called for one of them,
+     * and the resulting accumulators, counts, sums of weights and measures become the fill values,
+     * so that the cells never touched have the values they would have in a table which is not paged.
+     */
+    template<typename F>
+    void for_untouched_cells(F f)
+    {
+        static_assert(Tpaged, "all cells of a table which is not paged are touched");
+        for (size_t p = 0; p < paged_cells<Tcells>::n_pages; ++p) {
+            if (!page_touched(p)) {
+                size_t cell = p * paged_cells<Tcells>::page_size;
+                f((int)cell);
+                // the page of the cell was allocated by f only
+                for (int k = 0; k < Taccumulators; k++) {
+                    acc[k].refill(cell);
+                }
+                if (has_count) {
+                    count.refill(cell);
+                }
+                if (has_sumweight) {
+                    sumweight.refill(cell);
+                }
+                for (int msr = 0; msr < Tmeasures; ++msr) {
+                    this->measure[msr].refill(cell);
+                }
+                if constexpr (Tcollections > 0) {
+                    coll.release(cell);
+                }
+                if constexpr (Textras > 0) {
+                    extra.release(cell);
+                }
+                if constexpr (Textremas > 0) {
+                    extrema.release(cell);
+                }
+                return;
+            }
+        }
+        // every page was touched, the fill values are not used
+    }
+
+    /**
+     * Pages of all accumulators, for writeOutputTable().
+     *
+     * Page p of accumulator k is at k * n_pages + p, nullptr if never touched.
+     */
+    std::vector<const double*> acc_pages() const
+    {
+        static_assert(Tpaged, "accumulators of a table which is not paged are not in pages");
+        std::vector<const double*> pages;
+        for (int k = 0; k < Taccumulators; k++) {
+            for (size_t p = 0; p < paged_cells<Tcells>::n_pages; ++p) {
+                pages.push_back(acc[k].page(p));
+            }
+        }
+        return pages;
+    }
+
+    /**
+     * Values of cells never touched of all accumulators, for writeOutputTable().
+     */
+    std::vector<double> acc_fill_values() const
+    {
+        static_assert(Tpaged, "accumulators of a table which is not paged have no fill value");
+        std::vector<double> values;
+        for (int k = 0; k < Taccumulators; k++) {
+            values.push_back(acc[k].fill_value());
+        }
+        return values;
+    }
+
+    /**
+     * Release accumulator storage, after the table is written.
+     *
+     * Count and sum of weights storage is released with the accumulators.
+     */
+    void release_accumulators()
+    {
+        if constexpr (Tpaged) {
+            for (int k = 0; k < Taccumulators; k++) {
+                acc[k].reset(0.0);
+            }
+        }
+        else {
+            acc_block.reset();
+        }
+    }
+
+    /**
+     * Write accumulators, counts, observation collections, extras, and extremas to a checkpoint.
+     */
+    void write_checkpoint(std::ostream& os) const
+    {
+        checkpoint_put(os, (int32_t)Tcells);
+        checkpoint_put(os, (int32_t)Taccumulators);
+        if constexpr (Tpaged) {
+            for (int k = 0; k < Taccumulators; k++) {
+                acc[k].write_checkpoint(os);
+            }
+            if (has_count) {
+                count.write_checkpoint(os);
+            }
+            if (has_sumweight) {
+                sumweight.write_checkpoint(os);
+            }
+        }
+        else {
+            for (int k = 0; k < Taccumulators; k++) {
+                os.write(reinterpret_cast<const char*>(acc[k]), Tcells * sizeof(double));
+            }
+            if (has_count) {
+                os.write(reinterpret_cast<const char*>(count), Tcells * sizeof(double));
+            }
+            if (has_sumweight) {
+                os.write(reinterpret_cast<const char*>(sumweight), Tcells * sizeof(double));
+            }
+        }
+        auto write_coll = [&os](const auto& obs) {
+            if constexpr (om_quantile_sketch_on) {
+                obs.write_checkpoint(os);
+            }
+            else {
+                checkpoint_put(os, (uint64_t)obs.size());
+                os.write(reinterpret_cast<const char*>(obs.data()), obs.size() * sizeof(double));
+            }
+        };
+        auto write_extra = [&os](double x) {
+            checkpoint_put(os, x);
+        };
+        auto write_extrema = [&os](const extrema_type& pr) {
+            pr.first.write_checkpoint(os);
+            pr.second.write_checkpoint(os);
+        };
+        if constexpr (Tpaged) {
+            coll.write_checkpoint(os, write_coll);
+            extra.write_checkpoint(os, write_extra);
+            extrema.write_checkpoint(os, write_extrema);
+        }
+        else {
+            for (auto& cell_coll : coll) {
+                for (auto& obs : cell_coll) {
+                    write_coll(obs);
+                }
+            }
+            for (auto& cell_extra : extra) {
+                for (double x : cell_extra) {
+                    write_extra(x);
+                }
+            }
+            for (auto& cell_extrema : extrema) {
+                for (auto& pr : cell_extrema) {
+                    write_extrema(pr);
+                }
+            }
+        }
+    }
+
+    /**
+     * Read accumulators, counts, observation collections, extras, and extremas from a checkpoint.
+     *
+     * @return false if the checkpoint was not written by this entity table.
+     */
+    bool read_checkpoint(std::istream& is)
+    {
+        int32_t cells = 0;
+        int32_t accumulators = 0;
+        checkpoint_get(is, cells);
+        checkpoint_get(is, accumulators);
+        if (!is || cells != Tcells || accumulators != Taccumulators) {
+            return false;
+        }
+        if constexpr (Tpaged) {
+            for (int k = 0; k < Taccumulators; k++) {
+                acc[k].read_checkpoint(is);
+            }
+            if (has_count) {
+                count.read_checkpoint(is);
+            }
+            if (has_sumweight) {
+                sumweight.read_checkpoint(is);
+            }
+        }
+        else {
+            for (int k = 0; k < Taccumulators; k++) {
+                is.read(reinterpret_cast<char*>(acc[k]), Tcells * sizeof(double));
+            }
+            if (has_count) {
+                is.read(reinterpret_cast<char*>(count), Tcells * sizeof(double));
+            }
+            if (has_sumweight) {
+                is.read(reinterpret_cast<char*>(sumweight), Tcells * sizeof(double));
+            }
+        }
+        auto read_coll = [&is](auto& obs) {
+            if constexpr (om_quantile_sketch_on) {
+                obs.read_checkpoint(is);
+            }
+            else {
+                uint64_t n = 0;
+                checkpoint_get(is, n);
+                obs.clear();
+                if (is) {
+                    obs.resize((size_t)n);
+                    is.read(reinterpret_cast<char*>(obs.data()), n * sizeof(double));
+                }
+            }
+        };
+        auto read_extra = [&is](double& x) {
+            checkpoint_get(is, x);
+        };
+        auto read_extrema = [&is](extrema_type& pr) {
+            pr.first.read_checkpoint(is);
+            pr.second.read_checkpoint(is);
+        };
+        if constexpr (Tpaged) {
+            coll.read_checkpoint(is, read_coll);
+            extra.read_checkpoint(is, read_extra);
+            extrema.read_checkpoint(is, read_extrema);
+        }
+        else {
+            for (auto& cell_coll : coll) {
+                for (auto& obs : cell_coll) {
+                    read_coll(obs);
+                }
+            }
+            for (auto& cell_extra : extra) {
+                for (double& x : cell_extra) {
+                    read_extra(x);
+                }
+            }
+            for (auto& cell_extrema : extrema) {
+                for (auto& pr : cell_extrema) {
+                    read_extrema(pr);
+                }
+            }
+        }
+        return (bool)is;
+    }
+
     /**
      * The number of accumulators in the entity table.
      */
     static const int n_accumulators = Taccumulators;
 
+    /**
+     * Indicates if accumulators are allocated in pages on first touch.
+     */
+    static const bool is_paged = Tpaged;
+
+    /**
+     * The number of cells in a page of accumulators, if paged.
+     */
+    static const size_t page_size = paged_cells<Tcells>::page_size;
+
     /**
      * Indicates if the entity table supports count for each cell.
      */
@@ -243,35 +682,38 @@ public:
     /**
      * Accumulator storage.
      */
-    double * acc[Taccumulators];            // acc[Taccumulators][Tcells]
-    std::forward_list<std::unique_ptr<double[]> > acc_storage;
+    cells_type acc[Taccumulators];          // acc[Taccumulators][Tcells]
+    table_block acc_block;                  // acc[k] is at offset k * cell_stride, then count and sumweight, unless Tpaged
 
     /**
      * Count storage.
      */
-    std::unique_ptr<double[]> count; // count[Tcells], provided Thas_count is true
+    count_type count = count_type(); // count[Tcells], provided Thas_count is true
 
     /**
      * Sum of weights storage.
      */
-    std::unique_ptr<double[]> sumweight; // sumweight[Tcells], provided Thas_sumweight is true
+    count_type sumweight = count_type(); // sumweight[Tcells], provided Thas_sumweight is true
 
     /**
      * observation collections storage
      */
-    std::array<std::array<std::forward_list<double>, Tcollections>, Tcells> coll; // coll[Tcells][Tcollections]
+    per_cell_storage<obs_collection_type, Tcollections, Tcells, Tpaged> coll; // coll[Tcells][Tcollections]
 
     /**
      * Extras storage.
      */
-    std::array<std::array<double, Textras>, Tcells> extra; // extra[Tcells][Textras]
+    per_cell_storage<double, Textras, Tcells, Tpaged> extra; // extra[Tcells][Textras]
+
+    /**
+     * An extrema, a pair of fixed-capacity heaps, first holds lowest values, second holds highest values.
+     */
+    typedef std::pair<extrema_heap<std::less<double>>, extrema_heap<std::greater<double>>> extrema_type;
 
     /**
      * Extremas storage.
-     * 
-     * Each extrema is a pair of multisets, first holds lowest values, second holds highest values.
      */
-    std::array<std::array<std::pair<std::multiset<double>, std::multiset<double>>, Textremas>, Tcells> extrema; // extrema[Tcells][Textremas]
+    per_cell_storage<extrema_type, Textremas, Tcells, Tpaged> extrema; // extrema[Tcells][Textremas]
 };
 
 /**
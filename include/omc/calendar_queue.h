@@ -0,0 +1,311 @@
+/**
+* @file    calendar_queue.h
+* Implementation of a calendar queue
+*
+* A calendar queue (R. Brown, "Calendar Queues: A Fast O(1) Priority Queue Implementation
+* for the Simulation Event Set Problem", CACM 31(10), 1988) distributes elements into
+* an array of buckets (the days of a year) by time.  Each bucket covers a time interval
+* of a fixed width, and bucket i contains elements for day i of every year.
+* The next element is found by scanning the buckets of the current year in order.
+* When the number of elements and the number of buckets diverge, the calendar is rebuilt
+* with a bucket width derived from the observed separation of successive front elements.
+*
+* In this implementation each bucket is an indexed heap ordered by CMP, and each element stores its position
+* in its bucket in the member queue_index, so that an arbitrary element can be removed in O(log b),
+* where b is the size of its bucket.  Because CMP is consistent with time, the element at the top
+* of a bucket is also on its earliest day, so the front element of a day is found in O(1).
+* Elements with equal times all fall in the same bucket, and are ordered by the heap of the bucket,
+* so ties in time are resolved exactly as in std::set using the same CMP, in O(log b) for each.
+*
+* The queue presents the subset of the std::set interface used by the event queue
+* (insert, erase, begin, empty, size) so that the two can be exchanged.
+* Unlike std::set, only the element referred to by begin() is ordered.
+*/
+// Copyright (c) 2013-2026 OpenM++ Contributors
+// This code is licensed under the MIT license (see LICENSE.txt for details)
+
+#pragma once
+
+#include <vector>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <functional>
+#include "omc/indexed_heap.h"
+
+/**
+ * A calendar queue of pointers with position stored in the pointed-to object.
+ *
+ * @tparam T   Pointer type of the element, T must point to an object with members event_time and queue_index.
+ * @tparam CMP Comparison functor, a strict weak ordering on T consistent with event_time.
+ */
+template<typename T, typename CMP = std::less<T> >
+class calendar_queue
+{
+public:
+    calendar_queue()
+        : buckets(min_buckets)
+        , width(1.0)
+        , count(0)
+        , current_day(0)
+        , front(nullptr)
+        , last_front_time(std::numeric_limits<double>::quiet_NaN())
+        , separation_sum(0.0)
+        , separation_count(0)
+    {
+    }
+
+    /**
+     * Element at the front of the queue, i.e. which compares lowest.
+     *
+     * Only the element referred to by begin() is in order.
+     * The queue must not be empty.
+     */
+    const T* begin()
+    {
+        assert(count > 0);
+        if (!front) {
+            find_front();
+        }
+        return &front;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    /**
+     * Insert an element.
+     */
+    void insert(T x)
+    {
+        if (count + 1 > 2 * buckets.size()) {
+            resize(2 * buckets.size());
+        }
+        int64_t d = day_of(x);
+        if (count == 0 || d < current_day) {
+            // maintain invariant that no element is on a day before the current day
+            current_day = d;
+        }
+        buckets[bucket_of(d)].insert(x);
+        ++count;
+        if (front && cmp(x, front)) {
+            front = x;
+        }
+    }
+
+    /**
+     * Remove an element, which must be in the queue.
+     */
+    void erase(T x)
+    {
+        buckets[bucket_of(day_of(x))].erase(x);
+        --count;
+        if (x == front) {
+            front = nullptr;
+        }
+        if (count < buckets.size() / 4 && buckets.size() > min_buckets) {
+            resize(buckets.size() / 2);
+        }
+    }
+
+    /**
+     * Remove all elements.
+     */
+    void clear()
+    {
+        for (auto& bucket : buckets) {
+            bucket.clear();
+        }
+        count = 0;
+        current_day = 0;
+        front = nullptr;
+    }
+
+private:
+    /**
+     * Minimum number of buckets (a power of 2).
+     */
+    static const size_t min_buckets = 16;
+
+    /**
+     * Day number of an element, i.e. floor(time / width), clamped to avoid overflow.
+     *
+     * The function is non-decreasing in time, so an element on an earlier day is earlier in time.
+     */
+    int64_t day_of(T x) const
+    {
+        double d = std::floor((double)x->event_time / width);
+        const double limit = 4.0e18;
+        if (d > limit) return (int64_t)limit;
+        if (d < -limit) return -(int64_t)limit;
+        return (int64_t)d;
+    }
+
+    /**
+     * Bucket index of a day.
+     */
+    size_t bucket_of(int64_t day) const
+    {
+        return (size_t)((uint64_t)day & (uint64_t)(buckets.size() - 1));
+    }
+
+    /**
+     * Find the front element, starting from the current day.
+     *
+     * No element of the bucket of day d is on an earlier day, so the top of the bucket
+     * is the front element of day d if it is on day d, and otherwise day d is empty.
+     */
+    void find_front()
+    {
+        assert(count > 0);
+        size_t n = buckets.size();
+        // scan one year of days
+        for (size_t k = 0; k < n; ++k) {
+            int64_t d = current_day + (int64_t)k;
+            auto& bucket = buckets[bucket_of(d)];
+            if (!bucket.empty() && day_of(*bucket.begin()) == d) {
+                current_day = d;
+                set_front(*bucket.begin());
+                return;
+            }
+        }
+        // no element in the coming year, search the tops of all buckets directly
+        T best = nullptr;
+        for (auto& bucket : buckets) {
+            if (!bucket.empty() && (!best || cmp(*bucket.begin(), best))) {
+                best = *bucket.begin();
+            }
+        }
+        assert(best);
+        current_day = day_of(best);
+        set_front(best);
+    }
+
+    /**
+     * Record the front element, and observe its separation from the previous front element.
+     *
+     * Zero separations (ties) are not observed, since they would shrink the bucket width towards 0.
+     * Ties are ordered by the heap of their bucket instead.
+     */
+    void set_front(T x)
+    {
+        front = x;
+        double t = (double)x->event_time;
+        double separation = t - last_front_time; // NaN if no previous front element
+        if (separation > 0.0 && std::isfinite(separation)) {
+            separation_sum += separation;
+            ++separation_count;
+        }
+        last_front_time = t;
+    }
+
+    /**
+     * Rebuild the calendar with new_size buckets and a new bucket width.
+     */
+    void resize(size_t new_size)
+    {
+        if (new_size < min_buckets) {
+            new_size = min_buckets;
+        }
+        // collect all elements
+        std::vector<T> all;
+        all.reserve(count);
+        for (auto& bucket : buckets) {
+            all.insert(all.end(), bucket.begin(), bucket.end());
+        }
+        // Tune bucket width to 3 times the average separation of front elements (Brown 1988),
+        // or, lacking observations, to the average spacing of the elements in the queue.
+        double new_width = 0.0;
+        if (separation_count > 0) {
+            new_width = 3.0 * separation_sum / separation_count;
+        }
+        else if (all.size() > 1) {
+            double lo = (double)all[0]->event_time;
+            double hi = lo;
+            for (auto x : all) {
+                double t = (double)x->event_time;
+                if (t < lo) lo = t;
+                if (t > hi) hi = t;
+            }
+            new_width = 3.0 * (hi - lo) / all.size();
+        }
+        if (new_width > 0.0 && std::isfinite(new_width)) {
+            width = new_width;
+        }
+        separation_sum = 0.0;
+        separation_count = 0;
+        // redistribute elements
+        buckets.assign(new_size, bucket_type());
+        bool first = true;
+        for (auto x : all) {
+            int64_t d = day_of(x);
+            buckets[bucket_of(d)].insert(x);
+            if (first || d < current_day) {
+                current_day = d;
+                first = false;
+            }
+        }
+        front = nullptr;
+    }
+
+    /**
+     * A bucket, ordered by CMP.
+     */
+    typedef indexed_heap<T, CMP> bucket_type;
+
+    /**
+     * The buckets, the number of which is a power of 2.
+     */
+    std::vector<bucket_type> buckets;
+
+    /**
+     * Width in time of a bucket (a day).
+     */
+    double width;
+
+    /**
+     * Number of elements in the queue.
+     */
+    size_t count;
+
+    /**
+     * Day from which the search for the front element starts.
+     *
+     * No element is on an earlier day.
+     */
+    int64_t current_day;
+
+    /**
+     * Cached front element, nullptr if unknown.
+     */
+    T front;
+
+    /**
+     * Time of the previous front element, for observation of separations.
+     */
+    double last_front_time;
+
+    /**
+     * Sum of observed separations of successive front elements since the last resize.
+     */
+    double separation_sum;
+
+    /**
+     * Count of observed separations of successive front elements since the last resize.
+     */
+    size_t separation_count;
+
+    /**
+     * Comparison functor.
+     */
+    CMP cmp;
+};
@@ -0,0 +1,80 @@
+/**
+* @file    checkpoint.h
+* Helpers to write and read the simulation state of a member to a binary checkpoint file
+*
+* A checkpoint is a sequence of values in the native binary representation of the machine,
+* so a checkpoint can only be read by the same model executable which wrote it.
+* Containers are written as a count followed by their elements.
+*/
+// Copyright (c) 2013-2026 OpenM++ Contributors
+// This code is licensed under the MIT license (see LICENSE.txt for details)
+
+#pragma once
+
+#include <istream>
+#include <ostream>
+#include <fstream>
+#include <string>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * Write a value of a trivially copyable type to a checkpoint.
+ */
+template<typename T>
+void checkpoint_put(std::ostream& os, const T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "checkpoint_put requires a trivially copyable type");
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * Read a value of a trivially copyable type from a checkpoint.
+ */
+template<typename T>
+void checkpoint_get(std::istream& is, T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "checkpoint_get requires a trivially copyable type");
+    is.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+/**
+ * Write a string to a checkpoint.
+ */
+inline void checkpoint_put(std::ostream& os, const std::string& value)
+{
+    checkpoint_put(os, (uint64_t)value.size());
+    os.write(value.data(), value.size());
+}
+
+/**
+ * Read a string from a checkpoint.
+ */
+inline void checkpoint_get(std::istream& is, std::string& value)
+{
+    uint64_t n = 0;
+    checkpoint_get(is, n);
+    if (!is || n > (1 << 20)) {
+        // not a string written by checkpoint_put
+        is.setstate(std::ios::failbit);
+        return;
+    }
+    value.resize((size_t)n);
+    is.read(&value[0], n);
+}
+
+/**
+ * Write the accumulators of all entity tables to a checkpoint.
+ *
+ * The function definition is generated by the ompp compiler.
+ */
+void om_checkpoint_write_tables(std::ostream& os);
+
+/**
+ * Read the accumulators of all entity tables from a checkpoint.
+ *
+ * The function definition is generated by the ompp compiler.
+ *
+ * @return false if the checkpoint does not match the entity tables of the model.
+ */
+bool om_checkpoint_read_tables(std::istream& is);
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <functional>
 #include <array>
+#include <vector>
 
 /**
  * A finite discrete distribution.
@@ -127,13 +128,134 @@ public:
 
 };
 
+/**
+ * A finite discrete distribution drawn in constant time using an alias table.
+ * 
+ * The table is built by Vose's method.  Each value i has a threshold probability and an alias.
+ * A draw selects a value i uniformly and returns i if the remaining fraction of the uniform
+ * is below the threshold of i, otherwise the alias of i.
+ * Draws have the same distribution as cumrate_distribution, but not the same results for a given uniform.
+ *
+ * @tparam N Number of values.
+ */
+template<int N>
+class cumrate_alias_distribution
+{
+public:
+    cumrate_alias_distribution()
+        : is_degenerate(false)
+        , is_initialized(false)
+    {}
+
+    /**
+     * Initialize the distribution
+     *
+     * @param freq The frequency of each value
+     */
+    void initialize(const double *freq)
+    {
+        assert(freq); // logic guarantee
+        is_degenerate = false;
+        is_initialized = false;
+
+        // calculate the total of all frequencies
+        double total = 0.0;
+        for (int i = 0; i < N; ++i) {
+            total += freq[i];
+        }
+
+        // each value is its own alias until paired
+        std::iota(alias.begin(), alias.end(), 0);
+
+        if (total == 0.0) {
+            // If the distribution is degenerate, all values are equally likely.
+            threshold.fill(1.0);
+            is_degenerate = true;
+            is_initialized = true;
+            return;
+        }
+
+        // probabilities scaled by N, which average 1
+        std::vector<int> small;
+        std::vector<int> large;
+        for (int i = 0; i < N; ++i) {
+            threshold[i] = N * freq[i] / total;
+            if (threshold[i] < 1.0) {
+                small.push_back(i);
+            }
+            else {
+                large.push_back(i);
+            }
+        }
+
+        // pair each value below 1 with a value above 1 which fills its remainder
+        while (!small.empty() && !large.empty()) {
+            int s = small.back();
+            small.pop_back();
+            int l = large.back();
+            alias[s] = l;
+            threshold[l] -= 1.0 - threshold[s];
+            if (threshold[l] < 1.0) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+
+        // remaining values are 1, up to rounding
+        for (int i : large) {
+            threshold[i] = 1.0;
+        }
+        for (int i : small) {
+            threshold[i] = 1.0;
+        }
+        is_initialized = true;
+    }
+
+    /**
+     * Draws an element from the discrete probability distribution
+     * 
+     * @param uniform A random uniform on (0,1)
+     *
+     * @return The integer value in {0,...,N-1}
+     */
+    int draw(double uniform)
+    {
+        assert(is_initialized); // must be initialized before use
+        double x = uniform * N;
+        int i = std::min((int)x, N - 1);
+        return (x - i < threshold[i]) ? i : alias[i];
+    }
+
+    /**
+     * true if distribution is degenerate (all frequencies are zero)
+     */
+    bool is_degenerate;
+
+    /**
+     * The probability of each value being returned when it is selected, rather than its alias.
+     */
+    std::array<double,N> threshold;
+
+    /**
+     * The value returned in place of each value when it is not kept.
+     */
+    std::array<int,N> alias;
+
+    /**
+     * true if distribution has been initialized
+     */
+    bool is_initialized;
+
+};
+
 /**
  * Encapsulates an array of finite discrete distributions.
  * 
  * @tparam M Number of distributions.
  * @tparam N Number of values in each distribution.
+ * @tparam D Type of each distribution, cumrate_distribution or cumrate_alias_distribution.
  */
-template<int M, int N>
+template<int M, int N, typename D = cumrate_distribution<N>>
 class cumrate
 {
 public:
@@ -188,7 +310,7 @@ private:
     /**
      * The M distributions, each with N values.
      */
-    cumrate_distribution<N> distns[M];
+    D distns[M];
 
     /**
      * true if cumrate has been initialized
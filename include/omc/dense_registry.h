@@ -0,0 +1,139 @@
+/**
+* @file    dense_registry.h
+* Implementation of a registry of objects stored contiguously
+*
+* The registry stores pointers to objects in a vector, in order of insertion.
+* Each object stores its own position in the registry in a member given as a template argument,
+* so that an object can be removed in O(1) without a search, and without any per-object
+* memory allocation.  A removed object leaves an empty slot, so that the order of the
+* remaining objects is unchanged.  Empty slots are squeezed out when they outnumber
+* the objects in the registry, unless an iteration is in progress.
+*
+* Iteration visits objects from the most recently inserted to the least recently inserted,
+* which is the order of a std::list to which objects are added by push_front.
+* An iteration is robust to removal of any object, and does not visit objects inserted
+* after it started.
+*/
+// Copyright (c) 2013-2026 OpenM++ Contributors
+// This code is licensed under the MIT license (see LICENSE.txt for details)
+
+#pragma once
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+/**
+ * A registry of pointers with position stored in the pointed-to object.
+ *
+ * @tparam T     Type of the registered object.
+ * @tparam Index Member of T of type size_t which stores the position of the object in the registry.
+ */
+template<typename T, size_t T::*Index>
+class dense_registry
+{
+public:
+    dense_registry()
+        : count(0)
+        , iterating(0)
+    {
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    /**
+     * Number of objects in the registry.
+     */
+    size_t size() const
+    {
+        return count;
+    }
+
+    /**
+     * Add an object to the registry.
+     */
+    void insert(T *x)
+    {
+        x->*Index = slots.size();
+        slots.push_back(x);
+        ++count;
+    }
+
+    /**
+     * Remove an object, which must be in the registry.
+     */
+    void erase(T *x)
+    {
+        size_t i = x->*Index;
+        assert(i < slots.size() && slots[i] == x);
+        slots[i] = nullptr;
+        --count;
+        if (iterating == 0) {
+            // trim empty slots at the end
+            while (!slots.empty() && slots.back() == nullptr) {
+                slots.pop_back();
+            }
+            if (slots.size() - count > count + min_holes) {
+                compact();
+            }
+        }
+    }
+
+    /**
+     * Call f for each object in the registry, most recently inserted first.
+     *
+     * f may remove any object from the registry, or insert objects into the registry.
+     */
+    template<typename F>
+    void for_each(F f)
+    {
+        ++iterating;
+        for (size_t i = slots.size(); i > 0; --i) {
+            T *x = slots[i - 1];
+            if (x) {
+                f(x);
+            }
+        }
+        --iterating;
+    }
+
+private:
+    /**
+     * Remove empty slots, preserving the order of objects.
+     */
+    void compact()
+    {
+        size_t j = 0;
+        for (size_t i = 0; i < slots.size(); ++i) {
+            T *x = slots[i];
+            if (x) {
+                x->*Index = j;
+                slots[j++] = x;
+            }
+        }
+        slots.resize(j);
+    }
+
+    /**
+     * Number of empty slots tolerated regardless of the number of objects.
+     */
+    static const size_t min_holes = 64;
+
+    /**
+     * Objects in order of insertion, nullptr for a removed object.
+     */
+    std::vector<T *> slots;
+
+    /**
+     * Number of objects in the registry.
+     */
+    size_t count;
+
+    /**
+     * Depth of iterations in progress.
+     */
+    int iterating;
+};
@@ -0,0 +1,101 @@
+/**
+* @file    extrema_heap.h
+* Implementation of a fixed-capacity collection of the most extreme observations
+*
+* The collection keeps the M smallest (or largest) values of a stream of observations
+* in a binary heap whose top is the least extreme value kept.
+* An observation which is not more extreme than the top of a full heap is rejected
+* with a single comparison, otherwise it replaces the top.
+* Storage is allocated once, at the first observation, and never grows beyond M.
+*/
+// Copyright (c) 2013-2026 OpenM++ Contributors
+// This code is licensed under the MIT license (see LICENSE.txt for details)
+
+#pragma once
+
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include "omc/checkpoint.h"
+
+/**
+ * The M most extreme values of a collection of doubles.
+ *
+ * @tparam Compare std::less<double> to keep the smallest values, std::greater<double> to keep the largest values.
+ */
+template<typename Compare>
+class extrema_heap
+{
+public:
+    /**
+     * Add an observation, keeping no more than max_size values.
+     */
+    void insert(double x, size_t max_size)
+    {
+        if (heap.size() < max_size) {
+            if (heap.empty()) {
+                heap.reserve(max_size);
+            }
+            heap.push_back(x);
+            std::push_heap(heap.begin(), heap.end(), Compare());
+        }
+        else if (max_size > 0 && Compare()(x, heap.front())) {
+            // x displaces the least extreme value kept
+            std::pop_heap(heap.begin(), heap.end(), Compare());
+            heap.back() = x;
+            std::push_heap(heap.begin(), heap.end(), Compare());
+        }
+        // else reject x
+    }
+
+    size_t size() const
+    {
+        return heap.size();
+    }
+
+    void clear()
+    {
+        heap.clear();
+    }
+
+    /**
+     * The values kept, as the sorted collection passed to the screening transformation functions.
+     */
+    std::multiset<double> sorted() const
+    {
+        auto values = heap;
+        std::sort(values.begin(), values.end());
+        return std::multiset<double>(values.begin(), values.end());
+    }
+
+    /**
+     * Write the values kept to a checkpoint.
+     */
+    void write_checkpoint(std::ostream& os) const
+    {
+        checkpoint_put(os, (uint64_t)heap.size());
+        os.write(reinterpret_cast<const char*>(heap.data()), heap.size() * sizeof(double));
+    }
+
+    /**
+     * Read the values kept from a checkpoint.
+     */
+    void read_checkpoint(std::istream& is)
+    {
+        uint64_t n = 0;
+        checkpoint_get(is, n);
+        heap.clear();
+        if (is) {
+            heap.resize((size_t)n);
+            is.read(reinterpret_cast<char*>(heap.data()), n * sizeof(double));
+        }
+    }
+
+private:
+    /**
+     * Values kept, as a heap with the least extreme value on top.
+     */
+    std::vector<double> heap;
+};
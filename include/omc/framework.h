@@ -111,4 +111,26 @@ namespace fmk {
      * Default value of % progress messages during simulation
      */
     const inline int progress_percent_default = 1;
+
+    /**
+     * Number of cases between checkpoints of a simulation member, or 0 if no checkpoints.
+     *
+     * Set by the model development option Checkpoint.Cases.
+     * Model state carried across cases, such as case_info, is not part of a checkpoint.
+     */
+    long long inline checkpoint_cases = 0;
+
+    /**
+     * Directory of checkpoint files, or empty for the current directory.
+     *
+     * Set by the model development option Checkpoint.Dir.
+     */
+    std::string inline checkpoint_dir;
+
+    /**
+     * If true, a simulation member resumes from its checkpoint file, if it exists.
+     *
+     * Set by the model development option Checkpoint.Resume.
+     */
+    bool inline checkpoint_resume = false;
 }
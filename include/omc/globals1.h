@@ -170,6 +170,9 @@ extern void delete_streams();
 extern void initialize_stream(int model_stream, int member, long seed);
 random_state serialize_random_state();
 void deserialize_random_state(const random_state & rs);
+typedef std::vector<unsigned char> random_state_binary; // type used to store state of all streams in binary form
+random_state_binary serialize_random_state_binary();
+void deserialize_random_state_binary(const random_state_binary & rs);
 extern double RandUniform(int strm);
 extern double RandNormal(int strm);
 extern double RandLogistic(int strm);
@@ -0,0 +1,190 @@
+/**
+* @file    indexed_heap.h
+* Implementation of a d-ary indexed heap
+*
+* The heap stores pointers to objects in a contiguous vector.
+* Each object stores its own current position in the heap in the member
+* queue_index, so that an arbitrary object can be removed or repositioned in O(log n)
+* without a search, and without any per-element memory allocation.
+*
+* The heap presents the subset of the std::set interface used by the event queue
+* (insert, erase, begin, empty, size) so that the two can be exchanged.
+* Unlike std::set, only the element referred to by begin() is ordered,
+* which is the element which compares lowest according to CMP.
+* If CMP is a strict total order, as is the case for events,
+* the sequence of elements obtained by repeatedly removing begin()
+* is identical to the sequence obtained from std::set.
+*/
+// Copyright (c) 2013-2026 OpenM++ Contributors
+// This code is licensed under the MIT license (see LICENSE.txt for details)
+
+#pragma once
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+
+/**
+ * A d-ary heap of pointers with position stored in the pointed-to object.
+ *
+ * @tparam T   Pointer type of the element, T must point to an object with a member queue_index.
+ * @tparam CMP Comparison functor, a strict weak ordering on T.
+ * @tparam D   Arity of the heap (number of children of each node).
+ */
+template<typename T, typename CMP = std::less<T>, size_t D = 4>
+class indexed_heap
+{
+public:
+    static_assert(D >= 2, "arity of indexed_heap must be at least 2");
+
+    typedef typename std::vector<T>::const_iterator const_iterator;
+
+    /**
+     * Element at the front of the queue, i.e. which compares lowest.
+     *
+     * Only the element referred to by begin() is in order.
+     */
+    const_iterator begin() const
+    {
+        return heap.cbegin();
+    }
+
+    /**
+     * End of storage, for symmetry with begin().
+     */
+    const_iterator end() const
+    {
+        return heap.cend();
+    }
+
+    bool empty() const
+    {
+        return heap.empty();
+    }
+
+    size_t size() const
+    {
+        return heap.size();
+    }
+
+    /**
+     * Reserve storage for n elements.
+     */
+    void reserve(size_t n)
+    {
+        heap.reserve(n);
+    }
+
+    /**
+     * Insert an element.
+     */
+    void insert(T x)
+    {
+        size_t i = heap.size();
+        heap.push_back(x);
+        sift_up(i);
+    }
+
+    /**
+     * Remove an element, which must be in the heap.
+     */
+    void erase(T x)
+    {
+        size_t i = x->queue_index;
+        assert(i < heap.size() && heap[i] == x);
+        size_t last = heap.size() - 1;
+        if (i != last) {
+            place(heap[last], i);
+            heap.pop_back();
+            // the element moved into the vacated position may need to move either way
+            if (i > 0 && cmp(heap[i], heap[parent(i)])) {
+                sift_up(i);
+            }
+            else {
+                sift_down(i);
+            }
+        }
+        else {
+            heap.pop_back();
+        }
+    }
+
+    /**
+     * Remove all elements.
+     */
+    void clear()
+    {
+        heap.clear();
+    }
+
+private:
+    static size_t parent(size_t i)
+    {
+        return (i - 1) / D;
+    }
+
+    static size_t first_child(size_t i)
+    {
+        return D * i + 1;
+    }
+
+    /**
+     * Place element x at position i and record the position in x.
+     */
+    void place(T x, size_t i)
+    {
+        heap[i] = x;
+        x->queue_index = (decltype(x->queue_index))i;
+    }
+
+    void sift_up(size_t i)
+    {
+        T x = heap[i];
+        while (i > 0) {
+            size_t p = parent(i);
+            if (!cmp(x, heap[p])) {
+                break;
+            }
+            place(heap[p], i);
+            i = p;
+        }
+        place(x, i);
+    }
+
+    void sift_down(size_t i)
+    {
+        T x = heap[i];
+        size_t n = heap.size();
+        while (true) {
+            size_t c = first_child(i);
+            if (c >= n) {
+                break;
+            }
+            // find the lowest child
+            size_t c_end = (c + D < n) ? c + D : n;
+            size_t best = c;
+            for (size_t j = c + 1; j < c_end; ++j) {
+                if (cmp(heap[j], heap[best])) {
+                    best = j;
+                }
+            }
+            if (!cmp(heap[best], x)) {
+                break;
+            }
+            place(heap[best], i);
+            i = best;
+        }
+        place(x, i);
+    }
+
+    /**
+     * Storage for the heap, root at position 0.
+     */
+    std::vector<T> heap;
+
+    /**
+     * Comparison functor.
+     */
+    CMP cmp;
+};
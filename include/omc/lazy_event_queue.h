@@ -0,0 +1,211 @@
+/**
+* @file    lazy_event_queue.h
+* Implementation of an event queue with lazy removal (tombstones)
+*
+* Removing an element does not search for its entry in the queue.
+* Instead, the element's generation counter is incremented, which leaves the existing entry
+* in place as a tombstone.  Tombstones are discarded when they surface at the front of the queue,
+* and by a periodic compaction when they outnumber live entries.
+*
+* Each entry holds a copy of the ordering information of the element (time and order_key),
+* so the queue is ordered without dereferencing elements.  The ordering is by time,
+* then by order_key, which is the ordering of BaseEvent::operator<.
+*
+* The queue presents the subset of the std::set interface used by the event queue
+* (insert, erase, begin, empty, size) so that the two can be exchanged.
+* Unlike std::set, only the element referred to by begin() is ordered.
+*/
+// Copyright (c) 2013-2026 OpenM++ Contributors
+// This code is licensed under the MIT license (see LICENSE.txt for details)
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * A binary heap of versioned entries with lazy removal.
+ *
+ * @tparam T Pointer type of the element, T must point to an object with members event_time, order_key,
+ *           and queue_index.  queue_index is used as the generation counter of the element,
+ *           and must not be modified other than by this queue.  In particular, it must not be reset
+ *           when the storage of an element is reused while tombstones of the element remain in the queue.
+ */
+template<typename T>
+class lazy_event_queue
+{
+public:
+    lazy_event_queue()
+        : stale_count(0)
+        , tombstones_skipped(0)
+        , tombstones_compacted(0)
+        , compactions(0)
+        , max_entries(0)
+    {
+    }
+
+    /**
+     * Element at the front of the queue.
+     *
+     * Tombstones at the front are discarded.
+     * Only the element referred to by begin() is in order.
+     * The queue must not be empty.
+     */
+    const T* begin()
+    {
+        assert(!empty());
+        while (is_stale(heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), later);
+            heap.pop_back();
+            --stale_count;
+            ++tombstones_skipped;
+        }
+        return &heap.front().element;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * Number of live elements.
+     */
+    size_t size() const
+    {
+        return heap.size() - stale_count;
+    }
+
+    /**
+     * Insert an element.
+     */
+    void insert(T x)
+    {
+        heap.push_back(entry{ (double)x->event_time, x->order_key, x, x->queue_index });
+        std::push_heap(heap.begin(), heap.end(), later);
+        if (max_entries < heap.size()) {
+            max_entries = heap.size();
+        }
+    }
+
+    /**
+     * Remove an element, which must be in the queue.
+     *
+     * The entry of the element becomes a tombstone.
+     */
+    void erase(T x)
+    {
+        assert(size() > 0);
+        ++x->queue_index;
+        ++stale_count;
+        if (stale_count == heap.size()) {
+            // all entries are tombstones
+            tombstones_compacted += stale_count;
+            heap.clear();
+            stale_count = 0;
+        }
+        else if (stale_count > heap.size() / 2 && heap.size() >= compaction_threshold) {
+            compact();
+        }
+    }
+
+    /**
+     * Remove all elements.
+     */
+    void clear()
+    {
+        heap.clear();
+        stale_count = 0;
+    }
+
+    /**
+     * Resource use information for the queue.
+     */
+    auto resource_use() const
+    {
+        struct result { size_t tombstones_skipped; size_t tombstones_compacted; size_t compactions; size_t max_entries; };
+        return result{ tombstones_skipped, tombstones_compacted, compactions, max_entries };
+    }
+
+private:
+    /**
+     * An entry in the queue, with a copy of the ordering information of the element.
+     */
+    struct entry {
+        double time;
+        uint64_t order_key;
+        T element;
+        decltype(std::declval<T>()->queue_index) generation;
+    };
+
+    /**
+     * Comparison of entries for a min-heap (true if lhs comes after rhs).
+     */
+    static bool later(const entry& lhs, const entry& rhs)
+    {
+        if (lhs.time != rhs.time) return lhs.time > rhs.time;
+        return lhs.order_key > rhs.order_key;
+    }
+
+    /**
+     * An entry is stale if its element was removed or re-inserted after the entry was made.
+     */
+    static bool is_stale(const entry& e)
+    {
+        return e.generation != e.element->queue_index;
+    }
+
+    /**
+     * Remove all tombstones and rebuild the heap.
+     */
+    void compact()
+    {
+        auto it = std::remove_if(heap.begin(), heap.end(), is_stale);
+        // a mismatch means that the generation of an element was modified other than by this queue
+        assert((size_t)(heap.end() - it) == stale_count);
+        heap.erase(it, heap.end());
+        std::make_heap(heap.begin(), heap.end(), later);
+        tombstones_compacted += stale_count;
+        stale_count = 0;
+        ++compactions;
+    }
+
+    /**
+     * Minimum number of entries before compaction is considered.
+     */
+    static const size_t compaction_threshold = 1024;
+
+    /**
+     * Storage for the heap.
+     */
+    std::vector<entry> heap;
+
+    /**
+     * Number of tombstones in the heap.
+     */
+    size_t stale_count;
+
+    /**
+     * Number of tombstones discarded at the front of the queue.
+     */
+    size_t tombstones_skipped;
+
+    /**
+     * Number of tombstones removed by compaction.
+     */
+    size_t tombstones_compacted;
+
+    /**
+     * Number of compactions.
+     */
+    size_t compactions;
+
+    /**
+     * Maximum number of entries (live and tombstones).
+     */
+    size_t max_entries;
+};
@@ -37,9 +37,11 @@
 #include "omc/Event.h"
 #include "omc/Multilink.h"
 #include "omc/EntitySet.h"
+#include "omc/checkpoint.h"
 #include "omc/Table.h"
 #include "omc/Increment.h"
 #include "omc/cumrate.h"
+#include "omc/ziggurat.h"
 #include "om_types1.h" // omc-generated higher-level model-specific types, eg classifications, ranges
 
 /**
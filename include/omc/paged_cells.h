@@ -0,0 +1,273 @@
+/**
+* @file    paged_cells.h
+* Implementation of the values of the cells of a sparse table, allocated in pages on first touch
+*
+* The cells are divided into pages of 512 doubles (4 KB).  A page is allocated when a cell
+* in the page is first accessed for update, and is initialized to the fill value.
+* Cells in pages which were never touched have the fill value, and take no memory
+* other than one pointer per page in the page directory.
+* Other values of the cells, such as observation collections, are allocated in pages
+* of the same cells by paged_cell_arrays.
+*/
+// Copyright (c) 2013-2026 OpenM++ Contributors
+// This code is licensed under the MIT license (see LICENSE.txt for details)
+
+#pragma once
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+#include "omc/checkpoint.h"
+
+/**
+ * The values of Tcells cells, allocated in pages on first touch.
+ *
+ * @tparam Tcells Number of cells.
+ */
+template<size_t Tcells>
+class paged_cells
+{
+public:
+    /**
+     * Number of cells in a page.
+     */
+    static constexpr size_t page_size = 512;
+
+    /**
+     * Number of pages.
+     */
+    static constexpr size_t n_pages = (Tcells + page_size - 1) / page_size;
+
+    paged_cells()
+        : pages(n_pages)
+        , fill(0.0)
+    {
+    }
+
+    /**
+     * Reference to the value of a cell, allocating its page if not already allocated.
+     */
+    double& operator[](size_t cell)
+    {
+        auto& pg = pages[cell / page_size];
+        if (!pg) {
+            pg.reset(new double[page_size]);
+            std::fill(pg.get(), pg.get() + page_size, fill);
+        }
+        return pg[cell % page_size];
+    }
+
+    /**
+     * Value of a cell, without allocating its page.
+     */
+    double get(size_t cell) const
+    {
+        auto& pg = pages[cell / page_size];
+        return pg ? pg[cell % page_size] : fill;
+    }
+
+    /**
+     * Release all pages and set all cells to value.
+     */
+    void reset(double value)
+    {
+        for (auto& pg : pages) {
+            pg.reset();
+        }
+        fill = value;
+    }
+
+    /**
+     * Make the value of a cell the fill value, and release its page.
+     *
+     * No other cell in the page of the cell may have been touched.
+     */
+    void refill(size_t cell)
+    {
+        auto& pg = pages[cell / page_size];
+        if (pg) {
+            fill = pg[cell % page_size];
+            pg.reset();
+        }
+    }
+
+    /**
+     * Page p, or nullptr if no cell in page p was touched.
+     */
+    const double* page(size_t p) const
+    {
+        return pages[p].get();
+    }
+
+    /**
+     * Value of the cells in pages which were never touched.
+     */
+    double fill_value() const
+    {
+        return fill;
+    }
+
+    /**
+     * Write the fill value and touched pages to a checkpoint.
+     */
+    void write_checkpoint(std::ostream& os) const
+    {
+        checkpoint_put(os, fill);
+        for (auto& pg : pages) {
+            checkpoint_put(os, (uint8_t)(pg ? 1 : 0));
+            if (pg) {
+                os.write(reinterpret_cast<const char*>(pg.get()), page_size * sizeof(double));
+            }
+        }
+    }
+
+    /**
+     * Read the fill value and touched pages from a checkpoint.
+     */
+    void read_checkpoint(std::istream& is)
+    {
+        double value = 0.0;
+        checkpoint_get(is, value);
+        reset(value);
+        for (auto& pg : pages) {
+            uint8_t present = 0;
+            checkpoint_get(is, present);
+            if (!is) {
+                return;
+            }
+            if (present) {
+                pg.reset(new double[page_size]);
+                is.read(reinterpret_cast<char*>(pg.get()), page_size * sizeof(double));
+            }
+        }
+    }
+
+private:
+    /**
+     * Page directory, nullptr for a page never touched.
+     */
+    std::vector<std::unique_ptr<double[]>> pages;
+
+    /**
+     * Value of the cells in pages never touched.
+     */
+    double fill;
+};
+
+/**
+ * N values of type T in each of Tcells cells, allocated in pages of cells on first touch.
+ *
+ * The pages hold the same cells as those of paged_cells<Tcells>.  The values of a page are
+ * value-initialized when the page is allocated, so cells in pages never touched have the
+ * values of a newly constructed T.  Takes no storage if N is 0.
+ *
+ * @tparam T      Type of the values.
+ * @tparam N      Number of values in each cell.
+ * @tparam Tcells Number of cells.
+ */
+template<typename T, int N, size_t Tcells>
+class paged_cell_arrays
+{
+public:
+    /**
+     * The values of a cell.
+     */
+    typedef std::array<T, N> cell_type;
+
+    /**
+     * Number of cells in a page.
+     */
+    static constexpr size_t page_size = paged_cells<Tcells>::page_size;
+
+    /**
+     * Number of pages.
+     */
+    static constexpr size_t n_pages = (N > 0) ? paged_cells<Tcells>::n_pages : 0;
+
+    paged_cell_arrays()
+        : pages(n_pages)
+    {
+    }
+
+    /**
+     * Reference to the values of a cell, allocating its page if not already allocated.
+     */
+    cell_type& operator[](size_t cell)
+    {
+        auto& pg = pages[cell / page_size];
+        if (!pg) {
+            pg.reset(new cell_type[page_size]());
+        }
+        return pg[cell % page_size];
+    }
+
+    /**
+     * Page p, or nullptr if no cell in page p was touched.
+     */
+    const cell_type* page(size_t p) const
+    {
+        return pages[p].get();
+    }
+
+    /**
+     * Release the page of a cell.
+     */
+    void release(size_t cell)
+    {
+        pages[cell / page_size].reset();
+    }
+
+    /**
+     * Write touched pages to a checkpoint.
+     *
+     * @param write_value Callable with argument (const T &) which writes a value.
+     */
+    template<typename F>
+    void write_checkpoint(std::ostream& os, F write_value) const
+    {
+        for (auto& pg : pages) {
+            checkpoint_put(os, (uint8_t)(pg ? 1 : 0));
+            if (pg) {
+                for (size_t j = 0; j < page_size; ++j) {
+                    for (auto& x : pg[j]) {
+                        write_value(x);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Read touched pages from a checkpoint.
+     *
+     * @param read_value Callable with argument (T &) which reads a value.
+     */
+    template<typename F>
+    void read_checkpoint(std::istream& is, F read_value)
+    {
+        for (auto& pg : pages) {
+            pg.reset();
+            uint8_t present = 0;
+            checkpoint_get(is, present);
+            if (!is) {
+                return;
+            }
+            if (present) {
+                pg.reset(new cell_type[page_size]());
+                for (size_t j = 0; j < page_size; ++j) {
+                    for (auto& x : pg[j]) {
+                        read_value(x);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    /**
+     * Page directory, nullptr for a page never touched.
+     */
+    std::vector<std::unique_ptr<cell_type[]>> pages;
+};
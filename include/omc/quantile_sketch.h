@@ -0,0 +1,275 @@
+/**
+* @file    quantile_sketch.h
+* Implementation of a bounded-memory quantile sketch for observation collections in entity tables
+*
+* The sketch is a KLL sketch (Karnin, Lang & Liberty 2016) with deterministic compaction.
+* Items are held in a hierarchy of compactors.  An item at level h stands for 2^h observations.
+* When the compactors are full, the lowest full level is sorted and every second item
+* is promoted to the next level, the other half being discarded.
+* The choice of odd or even items alternates at each level, so that results are reproducible
+* and the error of successive compactions tends to cancel.
+*
+* The sketch is exact until the number of observations exceeds its capacity K.
+* Thereafter the rank error of a quantile is roughly 1.7 / K of the number of observations,
+* and memory is about 3 * K doubles, independent of the number of observations.
+*/
+// Copyright (c) 2013-2026 OpenM++ Contributors
+// This code is licensed under the MIT license (see LICENSE.txt for details)
+
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+#include "omc/checkpoint.h"
+
+/**
+ * A mergeable sketch of a collection of doubles which answers quantile queries.
+ *
+ * @tparam K Capacity of the top compactor, which controls accuracy.
+ */
+template<int K>
+class quantile_sketch
+{
+    static_assert(K >= 8, "quantile_sketch capacity must be at least 8");
+
+public:
+    quantile_sketch()
+        : n(0)
+        , held(0)
+        , total_capacity(0)
+        , total_capacity_levels(0)
+    {
+    }
+
+    /**
+     * Add an observation.
+     */
+    void insert(double x)
+    {
+        if (levels.empty()) {
+            levels.emplace_back();
+        }
+        levels[0].items.push_back(x);
+        ++held;
+        ++n;
+        if (held > capacity_total()) {
+            compress();
+        }
+    }
+
+    /**
+     * Add the observations in another sketch.
+     */
+    void merge(const quantile_sketch& other)
+    {
+        if (other.levels.size() > levels.size()) {
+            levels.resize(other.levels.size());
+        }
+        for (size_t h = 0; h < other.levels.size(); ++h) {
+            auto& src = other.levels[h].items;
+            levels[h].items.insert(levels[h].items.end(), src.begin(), src.end());
+            held += src.size();
+        }
+        n += other.n;
+        while (held > capacity_total()) {
+            compress();
+        }
+    }
+
+    /**
+     * Remove all observations.
+     */
+    void clear()
+    {
+        levels.clear();
+        n = 0;
+        held = 0;
+    }
+
+    bool empty() const
+    {
+        return n == 0;
+    }
+
+    /**
+     * Number of observations added to the sketch.
+     */
+    uint64_t count() const
+    {
+        return n;
+    }
+
+    /**
+     * Items retained by the sketch in increasing order, each paired with the number of observations it stands for.
+     *
+     * The weights sum to count().
+     */
+    std::vector<std::pair<double, double>> sorted() const
+    {
+        std::vector<std::pair<double, double>> result;
+        result.reserve(held);
+        double weight = 1.0;
+        for (auto& lvl : levels) {
+            for (double x : lvl.items) {
+                result.emplace_back(x, weight);
+            }
+            weight *= 2.0;
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    /**
+     * Approximate quantile: smallest retained item whose cumulative weight reaches q * count().
+     */
+    double quantile(double q) const
+    {
+        assert(n > 0);
+        auto items = sorted();
+        double target = q * (double)n;
+        double cum = 0.0;
+        for (auto& it : items) {
+            cum += it.second;
+            if (cum >= target) {
+                return it.first;
+            }
+        }
+        return items.back().first;
+    }
+
+    /**
+     * Write the sketch to a checkpoint.
+     */
+    void write_checkpoint(std::ostream& os) const
+    {
+        checkpoint_put(os, n);
+        checkpoint_put(os, (uint32_t)levels.size());
+        for (auto& lvl : levels) {
+            checkpoint_put(os, lvl.odd);
+            checkpoint_put(os, (uint64_t)lvl.items.size());
+            os.write(reinterpret_cast<const char*>(lvl.items.data()), lvl.items.size() * sizeof(double));
+        }
+    }
+
+    /**
+     * Read the sketch from a checkpoint.
+     */
+    void read_checkpoint(std::istream& is)
+    {
+        clear();
+        uint32_t n_levels = 0;
+        checkpoint_get(is, n);
+        checkpoint_get(is, n_levels);
+        if (!is || n_levels > 64) {
+            is.setstate(std::ios::failbit);
+            return;
+        }
+        levels.resize(n_levels);
+        for (auto& lvl : levels) {
+            uint64_t size = 0;
+            checkpoint_get(is, lvl.odd);
+            checkpoint_get(is, size);
+            if (!is || size > 8 * (uint64_t)K) {
+                is.setstate(std::ios::failbit);
+                return;
+            }
+            lvl.items.resize((size_t)size);
+            is.read(reinterpret_cast<char*>(lvl.items.data()), size * sizeof(double));
+            held += (size_t)size;
+        }
+    }
+
+private:
+    /**
+     * A compactor.
+     */
+    struct level
+    {
+        std::vector<double> items;
+        bool odd = false;       ///< keep odd items at the next compaction
+    };
+
+    /**
+     * Capacity of level h, which shrinks geometrically by 2/3 below the top level.
+     */
+    size_t capacity(size_t h) const
+    {
+        size_t depth = levels.size() - h - 1;
+        double cap = (double)K;
+        for (size_t i = 0; i < depth && cap > 2.0; ++i) {
+            cap *= 2.0 / 3.0;
+        }
+        return std::max<size_t>(2, (size_t)cap);
+    }
+
+    /**
+     * Capacity of all levels, recomputed only when the number of levels changes.
+     */
+    size_t capacity_total()
+    {
+        if (total_capacity_levels != levels.size()) {
+            total_capacity_levels = levels.size();
+            total_capacity = 0;
+            for (size_t h = 0; h < levels.size(); ++h) {
+                total_capacity += capacity(h);
+            }
+        }
+        return total_capacity;
+    }
+
+    /**
+     * Compact the lowest level which is at or above its capacity.
+     */
+    void compress()
+    {
+        for (size_t h = 0; h < levels.size(); ++h) {
+            if (levels[h].items.size() < capacity(h)) {
+                continue;
+            }
+            if (h + 1 == levels.size()) {
+                levels.emplace_back();
+            }
+            auto& src = levels[h].items;
+            std::sort(src.begin(), src.end());
+            // an odd item out stays at this level, the rest are halved
+            size_t m = src.size() & ~size_t(1);
+            size_t keep_from = (src.size() - m);
+            auto& dst = levels[h + 1].items;
+            for (size_t i = keep_from + (levels[h].odd ? 1 : 0); i < src.size(); i += 2) {
+                dst.push_back(src[i]);
+            }
+            levels[h].odd = !levels[h].odd;
+            src.resize(keep_from);
+            held -= m / 2;
+            return;
+        }
+    }
+
+    /**
+     * Compactors, level h items stand for 2^h observations.
+     */
+    std::vector<level> levels;
+
+    /**
+     * Number of observations.
+     */
+    uint64_t n;
+
+    /**
+     * Number of items retained over all levels.
+     */
+    size_t held;
+
+    /**
+     * Capacity of all levels, when there were total_capacity_levels levels.
+     */
+    size_t total_capacity;
+
+    /**
+     * Number of levels for which total_capacity was computed.
+     */
+    size_t total_capacity_levels;
+};
@@ -26,6 +26,8 @@
 #pragma once
 
 #include <functional>
+#include <new>
+#include "omc/slab_allocator.h"
 
 template<typename T>
 class rb_node
@@ -58,6 +60,75 @@ public:
     size_t size;
 };
 
+/**
+ * A pool of storage for nodes of red-black trees with keys of type T.
+ *
+ * Storage is obtained from a slab allocator, so nodes allocated in succession are adjacent
+ * in memory, and the storage of a deleted node is reused by the next node created.
+ * Storage is released when the pool is destroyed.
+ *
+ * @tparam T Type of the key.
+ */
+template<typename T>
+class rb_node_pool
+{
+public:
+    typedef rb_node<T> node_type;
+
+    rb_node_pool()
+        : free_list(nullptr)
+    {
+    }
+
+    rb_node_pool(const rb_node_pool&) = delete;
+    rb_node_pool& operator=(const rb_node_pool&) = delete;
+
+    /**
+     * Create a node, reusing the storage of a deleted node if possible.
+     */
+    node_type * create(T key, node_type * NIL)
+    {
+        void * storage;
+        if (free_list) {
+            storage = free_list;
+            free_list = free_list->next;
+        }
+        else {
+            storage = slab.allocate();
+        }
+        return ::new (storage) node_type(key, NIL);
+    }
+
+    /**
+     * Destroy a node created by create, and keep its storage for reuse.
+     */
+    void destroy(node_type * x)
+    {
+        x->~node_type();
+        free_list = ::new ((void *)x) free_node{ free_list };
+    }
+
+private:
+    /**
+     * Storage of a deleted node, in the list of storage available for reuse.
+     */
+    struct free_node {
+        free_node * next;
+    };
+
+    static_assert(sizeof(free_node) <= sizeof(node_type), "node storage too small for free list");
+
+    /**
+     * Source of storage for nodes.
+     */
+    slab_allocator<node_type> slab;
+
+    /**
+     * Storage of deleted nodes.
+     */
+    free_node * free_list;
+};
+
 template<typename T, typename CMP = std::less<T> >
 class rb_tree
 {
@@ -90,6 +161,31 @@ public:
 		delete NIL;
 	}
 
+    /**
+     * Create a node with the given key, for subsequent insertion in this tree.
+     */
+    node_type * new_node(T key)
+    {
+        return node_pool().create(key, NIL);
+    }
+
+    /**
+     * Delete a node created by new_node which is not in this tree.
+     */
+    void delete_node(node_type * x)
+    {
+        node_pool().destroy(x);
+    }
+
+    /**
+     * The pool of nodes shared by all trees with keys of type T in this thread.
+     */
+    static rb_node_pool<T> & node_pool()
+    {
+        static thread_local rb_node_pool<T> pool;
+        return pool;
+    }
+
 	/**
 	* Minimum value of subtree rooted at a node
 	*
@@ -523,7 +619,7 @@ public:
         if (x->right != NIL) {
             clear(x->right);
         }
-        delete x;
+        delete_node(x);
     }
 
     // Interface functions
@@ -0,0 +1,132 @@
+/**
+* @file    slab_allocator.h
+* Implementation of a slab allocator of uninitialized storage for objects of a single type
+*
+* Storage is obtained from the C++ memory allocator in large aligned chunks (slabs),
+* and handed out one object at a time in address order, so that objects allocated
+* in succession are adjacent in memory.  Storage is never returned to the slab allocator
+* object by object.  It is released all at once when the slab allocator is destroyed,
+* after the owner has destroyed the objects constructed in it.
+*/
+// Copyright (c) 2013-2026 OpenM++ Contributors
+// This code is licensed under the MIT license (see LICENSE.txt for details)
+
+#pragma once
+
+#include <vector>
+#include <new>
+#include <cassert>
+#include <cstddef>
+
+/**
+ * A slab allocator of storage for objects of type T.
+ *
+ * @tparam T Type of the object.
+ */
+template<typename T>
+class slab_allocator
+{
+public:
+    slab_allocator()
+        : next(nullptr)
+        , remaining(0)
+        , capacity(0)
+    {
+    }
+
+    ~slab_allocator()
+    {
+        for (auto s : slabs) {
+            ::operator delete(s, std::align_val_t(alignment));
+        }
+    }
+
+    slab_allocator(const slab_allocator&) = delete;
+    slab_allocator& operator=(const slab_allocator&) = delete;
+
+    /**
+     * Storage for one object, not initialized.
+     */
+    void *allocate()
+    {
+        if (remaining == 0) {
+            add_slab(slab_objects);
+        }
+        void *p = next;
+        next += sizeof(T);
+        --remaining;
+        return p;
+    }
+
+    /**
+     * Ensure that the next n allocations are contiguous and do not call the C++ memory allocator.
+     */
+    void reserve(size_t n)
+    {
+        if (n > remaining) {
+            add_slab(n);
+        }
+    }
+
+    /**
+     * Total number of objects for which storage was obtained.
+     */
+    size_t size() const
+    {
+        return capacity;
+    }
+
+    /**
+     * Number of slabs obtained from the C++ memory allocator.
+     */
+    size_t slab_count() const
+    {
+        return slabs.size();
+    }
+
+private:
+    /**
+     * Obtain a new slab with storage for n objects.
+     *
+     * Storage remaining in the current slab is abandoned.
+     */
+    void add_slab(size_t n)
+    {
+        assert(n > 0);
+        char *s = (char *)::operator new(n * sizeof(T), std::align_val_t(alignment));
+        slabs.push_back(s);
+        next = s;
+        remaining = n;
+        capacity += n;
+    }
+
+    /**
+     * Alignment of slabs, at least a cache line.
+     */
+    static constexpr size_t alignment = alignof(T) > 64 ? alignof(T) : 64;
+
+    /**
+     * Number of objects in a slab if no capacity is reserved, about 64KB and at least 16 objects.
+     */
+    static constexpr size_t slab_objects = (65536 / sizeof(T)) > 16 ? (65536 / sizeof(T)) : 16;
+
+    /**
+     * Slabs obtained from the C++ memory allocator.
+     */
+    std::vector<char *> slabs;
+
+    /**
+     * Next unallocated storage in the current slab.
+     */
+    char *next;
+
+    /**
+     * Number of objects remaining in the current slab.
+     */
+    size_t remaining;
+
+    /**
+     * Total number of objects in all slabs.
+     */
+    size_t capacity;
+};
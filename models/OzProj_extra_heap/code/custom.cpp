@@ -0,0 +1,10 @@
+/**
+ * @file   custom.cpp
+ * Custom C++ file for the model
+ * 
+ * This file is compiled and linked into the model.
+ * Place global definitions (if any) in this file.
+ * All global definitions must be thread-safe.
+ */
+
+// globals
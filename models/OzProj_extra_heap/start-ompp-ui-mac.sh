@@ -0,0 +1,8 @@
+#!/usr/bin/env bash
+
+if [ -z "$OM_ROOT" ] ;
+then
+  source ../start-model-ui-mac.sh
+else
+  source "$OM_ROOT"/models/start-model-ui-mac.sh
+fi
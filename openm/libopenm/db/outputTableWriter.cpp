@@ -36,6 +36,11 @@ namespace openm
         // write output table accumulator values
         void writeAccumulator(IDbExec * i_dbExec, int i_subId, int i_accId, size_t i_size, const double * i_valueArr) override;
 
+        // write output table accumulator values stored in pages
+        void writeAccumulator(
+            IDbExec * i_dbExec, int i_subId, int i_accId, size_t i_size, size_t i_pageSize, const double * const * i_pages, double i_fill
+            ) override;
+
         // write all output table values: aggregate sub-values using table expressions
         void writeAllExpressions(IDbExec * i_dbExec) override;
 
@@ -214,6 +219,17 @@ size_t IOutputTableWriter::sizeOf(const MetaHolder * i_metaStore, int i_tableId)
 
 // write output table accumulator values
 void OutputTableWriter::writeAccumulator(IDbExec * i_dbExec, int i_subId, int i_accId, size_t i_size, const double * i_valueArr)
+{
+    if (i_valueArr == nullptr) throw DbException("invalid value array: it can not be NULL for output table: %s", tableRow->tableName.c_str());
+
+    // all values in a single page
+    writeAccumulator(i_dbExec, i_subId, i_accId, i_size, i_size, &i_valueArr, numeric_limits<double>::quiet_NaN());
+}
+
+// write output table accumulator values stored in pages, NULL page values are equal to i_fill
+void OutputTableWriter::writeAccumulator(
+    IDbExec * i_dbExec, int i_subId, int i_accId, size_t i_size, size_t i_pageSize, const double * const * i_pages, double i_fill
+    )
 {
     // validate parameters
     if (i_dbExec == nullptr) throw DbException("invalid (NULL) database connection");
@@ -221,7 +237,11 @@ void OutputTableWriter::writeAccumulator(IDbExec * i_dbExec, int i_subId, int i_
     if (i_accId < 0 || i_accId >= accCount) throw DbException("invalid accumulator number: %d for output table: %s", i_accId, tableRow->tableName.c_str());
     if (i_size <= 0 || totalSize != i_size) throw DbException("invalid value array size: %zd for output table: %s", i_size, tableRow->tableName.c_str());
 
-    if (i_valueArr == nullptr) throw DbException("invalid value array: it can not be NULL for output table: %s", tableRow->tableName.c_str());
+    if (i_pageSize <= 0) throw DbException("invalid page size: %zd for output table: %s", i_pageSize, tableRow->tableName.c_str());
+    if (i_pages == nullptr) throw DbException("invalid value pages: it can not be NULL for output table: %s", tableRow->tableName.c_str());
+
+    // if table is "sparse" and fill value is not stored then skip pages where all values are equal to fill value
+    bool isFillStored = !isSparseTable || (isfinite(i_fill) && fabs(i_fill) > nullValue);
 
     // build sql:
     // INSERT INTO salarySex_a201208171604590148
@@ -269,37 +289,59 @@ void OutputTableWriter::writeAccumulator(IDbExec * i_dbExec, int i_subId, int i_
         unique_ptr<DbValue[]> valVecUptr(new DbValue[rowSize]);
         DbValue * valVec = valVecUptr.get();
 
-        // loop through all dimensions and store cell values
-        for (size_t cellOffset = 0; cellOffset < i_size; cellOffset++) {
+        // loop through all pages and store cell values
+        size_t pageCount = (i_size + i_pageSize - 1) / i_pageSize;
 
-            // set sql parameter values: dimension enum id by enum index
-            for (int nDim = 0; nDim < dimCount; nDim++) {
-                valVec[nDim] = DbValue(dimEnumIds[nDim][cellArr[nDim]]);
-            }
+        for (size_t nPage = 0; nPage < pageCount; nPage++) {
 
-            // if table is not "sparse" then store NULL value rows:
-            // if no "sparse" flag set for that output table or value is finite and greater than "sparse null"
-            if (!isSparseTable ||
-                (isfinite(i_valueArr[cellOffset]) && fabs(i_valueArr[cellOffset]) > nullValue)) {
+            const double * pageArr = i_pages[nPage];
+            if (pageArr == nullptr && !isFillStored) continue;  // skip page: no values to store
 
-                // set parameter value: accumulator value
-                valVec[dimCount] = DbValue(i_valueArr[cellOffset]);
+            // dimension enum indexes of the first cell in the page
+            size_t pageStart = nPage * i_pageSize;
+            size_t pos = pageStart;
 
-                // insert cell value into output table
-                i_dbExec->executeStatement(rowSize, valVec);
+            for (int nDim = dimCount - 1; nDim > 0; nDim--) {
+                cellArr[nDim] = (int)(pos % tableDims[nDim].dimSize);
+                pos /= tableDims[nDim].dimSize;
             }
+            if (dimCount > 0) cellArr[0] = (int)pos;
+
+            // loop through all dimensions and store cell values
+            size_t pageEnd = min(pageStart + i_pageSize, i_size);
+
+            for (size_t cellOffset = pageStart; cellOffset < pageEnd; cellOffset++) {
 
-            // get next cell indices
-            for (int nDim = dimCount - 1; nDim >= 0; nDim--) {
-                if (nDim > 0 && cellArr[nDim] >= tableDims[nDim].dimSize - 1) {
-                    cellArr[nDim] = 0;
+                double val = pageArr != nullptr ? pageArr[cellOffset - pageStart] : i_fill;
+
+                // set sql parameter values: dimension enum id by enum index
+                for (int nDim = 0; nDim < dimCount; nDim++) {
+                    valVec[nDim] = DbValue(dimEnumIds[nDim][cellArr[nDim]]);
                 }
-                else {
-                    cellArr[nDim]++;
-                    break;
+
+                // if table is not "sparse" then store NULL value rows:
+                // if no "sparse" flag set for that output table or value is finite and greater than "sparse null"
+                if (!isSparseTable || (isfinite(val) && fabs(val) > nullValue)) {
+
+                    // set parameter value: accumulator value
+                    valVec[dimCount] = DbValue(val);
+
+                    // insert cell value into output table
+                    i_dbExec->executeStatement(rowSize, valVec);
+                }
+
+                // get next cell indices
+                for (int nDim = dimCount - 1; nDim >= 0; nDim--) {
+                    if (nDim > 0 && cellArr[nDim] >= tableDims[nDim].dimSize - 1) {
+                        cellArr[nDim] = 0;
+                    }
+                    else {
+                        cellArr[nDim]++;
+                        break;
+                    }
                 }
+                if (cellOffset + 1 < i_size && dimCount > 0 && cellArr[0] >= tableDims[0].dimSize) throw DbException("Invalid value array size");
             }
-            if (cellOffset + 1 < i_size && dimCount > 0 && cellArr[0] >= tableDims[0].dimSize) throw DbException("Invalid value array size");
         }
     }   // done with insert
 
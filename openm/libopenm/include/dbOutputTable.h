@@ -64,6 +64,21 @@ namespace openm
             IDbExec * i_dbExec, int i_subId, int i_accId, size_t i_size, const double * i_valueArr
             ) = 0;
 
+        /**
+        * write output table accumulator values stored in pages
+        *
+        * @param[in] i_dbExec      database connection
+        * @param[in] i_subId       sub-value index
+        * @param[in] i_accId       accumulator number for the output table (zero based)
+        * @param[in] i_size        number of values for each accumulator
+        * @param[in] i_pageSize    number of values in each page
+        * @param[in] i_pages       pages of accumulator values, NULL if all values of the page are equal to i_fill
+        * @param[in] i_fill        value of the cells of a NULL page
+        */
+        virtual void writeAccumulator(
+            IDbExec * i_dbExec, int i_subId, int i_accId, size_t i_size, size_t i_pageSize, const double * const * i_pages, double i_fill
+            ) = 0;
+
         /** write all output table values: aggregate sub-values using table expressions */
         virtual void writeAllExpressions(IDbExec * i_dbExec) = 0;
 
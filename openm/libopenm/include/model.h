@@ -63,6 +63,14 @@ namespace openm
         /** write result into output table and release accumulators memory. */
         void writeOutputTable(const char * i_name, size_t i_size, forward_list<unique_ptr<double[]> > & io_accValues) override;
 
+        /** write result into output table from a block of accumulators, block memory is owned by the caller. */
+        void writeOutputTable(const char * i_name, size_t i_size, size_t i_count, size_t i_stride, const double * i_block) override;
+
+        /** write result into output table from pages of accumulators, pages memory is owned by the caller. */
+        void writeOutputTable(
+            const char * i_name, size_t i_size, size_t i_count, size_t i_pageSize, const double * const * i_pages, const double * i_fill
+            ) override;
+
         /** set modeling progress count and value */
         void updateProgress(int i_count, double i_value = 0.0) override { runCtrl->runStateStore().updateProgress(runId, runOpts.subValueId, i_count, i_value); }
 
@@ -107,6 +115,9 @@ namespace openm
         };
         vector<TableDoneItem> tableDoneVec;     // status for all output tables of sub-value
 
+        /** validate number of accumulators, mark output table as written and return true if it is the last table */
+        bool markTableDone(const char * i_name, int i_srcCount);
+
     private:
         ModelBase(const ModelBase & i_model) = delete;
         ModelBase & operator=(const ModelBase & i_model) = delete;
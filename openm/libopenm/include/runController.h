@@ -107,6 +107,29 @@ namespace openm
             forward_list<unique_ptr<double[]> > & io_accValues
             ) = 0;
 
+        /** write output table accumulators stored in a single block or send data to root process. */
+        virtual void writeAccumulators(
+            const RunOptions & i_runOpts,
+            bool i_isLastTable,
+            const char * i_name,
+            size_t i_size,
+            size_t i_count,
+            size_t i_stride,
+            const double * i_block
+            );
+
+        /** write output table accumulators stored in pages or send data to root process. */
+        virtual void writeAccumulators(
+            const RunOptions & i_runOpts,
+            bool i_isLastTable,
+            const char * i_name,
+            size_t i_size,
+            size_t i_count,
+            size_t i_pageSize,
+            const double * const * i_pages,
+            const double * i_fill
+            );
+
         /** return true if run option found by i_key in run_option table for the current run id. */
         bool isOptionExist(const char * i_key) const noexcept override {
             return metaStore->runOptionTable ? metaStore->runOptionTable->isExist(currentRunId(), i_key) : false;
@@ -253,6 +276,29 @@ namespace openm
             forward_list<unique_ptr<double[]> > & io_accValues
             ) const;
 
+        /** write output table accumulators if table is not suppressed. */
+        void doWriteAccumulators(
+            int i_runId,
+            IDbExec * i_dbExec,
+            const RunOptions & i_runOpts,
+            const char * i_name,
+            size_t i_size,
+            const vector<const double *> & i_accValues
+            ) const;
+
+        /** write output table accumulators stored in pages if table is not suppressed. */
+        void doWriteAccumulators(
+            int i_runId,
+            IDbExec * i_dbExec,
+            const RunOptions & i_runOpts,
+            const char * i_name,
+            size_t i_size,
+            size_t i_count,
+            size_t i_pageSize,
+            const double * const * i_pages,
+            const double * i_fill
+            ) const;
+
         /** update sub-value index to restart the run */
         void updateRestartSubValueId(int i_runId, IDbExec * i_dbExec, int i_subRestart) const;
 
@@ -121,12 +121,6 @@ void ModelBase::writeOutputTable(const char * i_name, size_t i_size, forward_lis
         forward_list<unique_ptr<double[]> > accValLst;
         accValLst.swap(io_accValues);                   // release accumulators memory at return
 
-        // find output table db row
-        const TableDicRow * tblRow = metaStore->tableDic->byModelIdName(modelId, i_name);
-        if (tblRow == nullptr) throw DbException("output table not found in tables dictionary: %s", i_name);
-
-        int tblId = tblRow->tableId;
-
         // validate accumulator(s) arrays
         int srcCount = 0;
         for (const auto & apc : accValLst) {
@@ -134,32 +128,114 @@ void ModelBase::writeOutputTable(const char * i_name, size_t i_size, forward_lis
             srcCount++;
         }
 
-        int accCount = (int)metaStore->tableAcc->countOf(
-            [&](const TableAccRow & i_row) -> bool { return i_row.modelId == modelId && i_row.tableId == tblRow->tableId; }
-        );
+        // update table write status and check if all tables completed
+        bool isLastTable = markTableDone(i_name, srcCount);
 
-        if (srcCount <= 0 || accCount != srcCount) throw DbException("invalid number of accumulators: %d for output table : %s", srcCount, i_name);
+        // write sub-value into database or start sending data to root process
+        runCtrl->writeAccumulators(runOpts, isLastTable, i_name, i_size, accValLst);
+    }
+    catch (exception & ex) {
+        throw ModelException("Failed to write output table: %s. %s", i_name, ex.what());
+    }
+}
+
+/** write result into output table from a single block of accumulators.
+*
+* @param   i_name    output table name
+* @param   i_size    number of cells in each accumulator
+* @param   i_count   number of accumulators
+* @param   i_stride  number of values from the start of one accumulator to the start of the next, at least i_size
+* @param   i_block   accumulator values, i_count arrays of i_size values each, i_stride values apart
+*
+* Unlike writeOutputTable() with a list of arrays, the accumulators are not copied and not released:
+* block memory is owned by the caller and can be released at return.
+*/
+void ModelBase::writeOutputTable(const char * i_name, size_t i_size, size_t i_count, size_t i_stride, const double * i_block)
+{
+    if (i_name == NULL || i_name[0] == '\0') throw ModelException("invalid (empty) output table name");
+    if (i_block == nullptr || i_count <= 0 || i_size <= 0) throw ModelException("invalid (empty) accumulators or size: %zd for output table %s", i_size, i_name);
+    if (i_stride < i_size) throw ModelException("invalid accumulators stride: %zd for output table %s", i_stride, i_name);
 
+    try {
         // update table write status and check if all tables completed
-        bool isLastTable = true;
-        bool isFound = false;
-        for (auto & td : tableDoneVec) {
-            if (td.tableId == tblId) {
-                td.isDone = true;
-                isFound = true;
-            }
-            if (!td.isDone) isLastTable = false;
-        }
-        if (!isFound) throw DbException("Failed attempt to write suppressed output table: %d %s", tblId, i_name);
+        bool isLastTable = markTableDone(i_name, (int)i_count);
 
         // write sub-value into database or start sending data to root process
-        runCtrl->writeAccumulators(runOpts, isLastTable, i_name, i_size, accValLst);
+        runCtrl->writeAccumulators(runOpts, isLastTable, i_name, i_size, i_count, i_stride, i_block);
     }
     catch (exception & ex) {
         throw ModelException("Failed to write output table: %s. %s", i_name, ex.what());
     }
 }
 
+/** write result into output table from pages of accumulators.
+*
+* @param   i_name      output table name
+* @param   i_size      number of cells in each accumulator
+* @param   i_count     number of accumulators
+* @param   i_pageSize  number of cells in each page
+* @param   i_pages     pages of accumulator values: page p of accumulator k is i_pages[k * ceil(i_size / i_pageSize) + p]
+* @param   i_fill      value of the cells of a NULL page for each accumulator
+*
+* A page is NULL if none of its cells was updated, for example:
+*
+* @code
+*      i_model->writeOutputTable("salaryBySex", N_cells, N_acc, page_size, acc_pages.data(), acc_fill.data());
+* @endcode
+*
+* Pages memory is owned by the caller and can be released at return.
+* If output is sparse then cells of NULL pages are not written when fill value is not stored.
+*/
+void ModelBase::writeOutputTable(
+    const char * i_name, size_t i_size, size_t i_count, size_t i_pageSize, const double * const * i_pages, const double * i_fill
+    )
+{
+    if (i_name == NULL || i_name[0] == '\0') throw ModelException("invalid (empty) output table name");
+    if (i_pages == nullptr || i_fill == nullptr || i_count <= 0 || i_size <= 0) throw ModelException("invalid (empty) accumulators or size: %zd for output table %s", i_size, i_name);
+    if (i_pageSize <= 0) throw ModelException("invalid accumulators page size: %zd for output table %s", i_pageSize, i_name);
+
+    try {
+        // update table write status and check if all tables completed
+        bool isLastTable = markTableDone(i_name, (int)i_count);
+
+        // write sub-value into database or start sending data to root process
+        runCtrl->writeAccumulators(runOpts, isLastTable, i_name, i_size, i_count, i_pageSize, i_pages, i_fill);
+    }
+    catch (exception & ex) {
+        throw ModelException("Failed to write output table: %s. %s", i_name, ex.what());
+    }
+}
+
+/** validate number of accumulators, mark output table as written and return true if all output tables of sub-value are written. */
+bool ModelBase::markTableDone(const char * i_name, int i_srcCount)
+{
+    // find output table db row
+    const TableDicRow * tblRow = metaStore->tableDic->byModelIdName(modelId, i_name);
+    if (tblRow == nullptr) throw DbException("output table not found in tables dictionary: %s", i_name);
+
+    int tblId = tblRow->tableId;
+
+    int accCount = (int)metaStore->tableAcc->countOf(
+        [&](const TableAccRow & i_row) -> bool { return i_row.modelId == modelId && i_row.tableId == tblRow->tableId; }
+    );
+
+    if (i_srcCount <= 0 || accCount != i_srcCount) throw DbException("invalid number of accumulators: %d for output table : %s", i_srcCount, i_name);
+
+    // update table write status and check if all tables completed
+    bool isLastTable = true;
+    bool isFound = false;
+    for (auto & td : tableDoneVec) {
+        if (td.tableId == tblId) {
+            td.isDone = true;
+            isFound = true;
+        }
+        if (!td.isDone) isLastTable = false;
+    }
+    if (!isFound) throw DbException("Failed attempt to write suppressed output table: %d %s", tblId, i_name);
+
+    return isLastTable;
+}
+
 /** write microdata into the database.
 *
 * @param   i_entityKind     entity kind id: model metadata entity id in database.
@@ -289,6 +289,38 @@ void RestartController::writeAccumulators(
     }
 }
 
+/** write output table accumulators stored in pages, without a copy.
+*
+* @param[in]     i_runOpts      model run options
+* @param[in]     i_isLastTable  if true then it is last output table to write
+* @param[in]     i_name         output table name
+* @param[in]     i_size         number of cells for each accumulator
+* @param[in]     i_count        number of accumulators
+* @param[in]     i_pageSize     number of cells in each page
+* @param[in]     i_pages        pages of accumulator values: i_count accumulators of ceil(i_size / i_pageSize) pages each
+* @param[in]     i_fill         value of the cells of a NULL page for each accumulator, can be NULL if there are no NULL pages
+*/
+void RestartController::writeAccumulators(
+    const RunOptions & i_runOpts,
+    bool i_isLastTable,
+    const char * i_name,
+    size_t i_size,
+    size_t i_count,
+    size_t i_pageSize,
+    const double * const * i_pages,
+    const double * i_fill
+    )
+{
+    // write accumulators into database
+    doWriteAccumulators(runId, dbExec, i_runOpts, i_name, i_size, i_count, i_pageSize, i_pages, i_fill);
+
+    // if all accumulators of sub-value completed then update restart sub-value index
+    if (i_isLastTable) {
+        isSubDone.setAt(i_runOpts.subValueId);      // mark that sub-value as completed
+        updateRestartSubValueId(runId, dbExec, isSubDone.countFirst());
+    }
+}
+
 /** communicate with between main therad and modeling threads to receive status update. */
 bool RestartController::childExchange(void)
 {
@@ -302,6 +302,44 @@ void RunController::doWriteAccumulators(
     size_t i_size,
     forward_list<unique_ptr<double[]> > & io_accValues
 ) const
+{
+    vector<const double *> accValues;
+    for (const auto & apc : io_accValues) {
+        accValues.push_back(apc.get());
+    }
+    doWriteAccumulators(i_runId, i_dbExec, i_runOpts, i_name, i_size, accValues);
+}
+
+/** write output table accumulators if table is not suppressed. */
+void RunController::doWriteAccumulators(
+    int i_runId,
+    IDbExec * i_dbExec,
+    const RunOptions & i_runOpts,
+    const char * i_name,
+    size_t i_size,
+    const vector<const double *> & i_accValues
+) const
+{
+    // each accumulator is a single page
+    doWriteAccumulators(i_runId, i_dbExec, i_runOpts, i_name, i_size, i_accValues.size(), i_size, i_accValues.data(), nullptr);
+}
+
+/** write output table accumulators stored in pages if table is not suppressed.
+*
+* Page k * ceil(i_size / i_pageSize) + p is page p of accumulator k.
+* If page is NULL then all cells of that page are equal to i_fill[k].
+*/
+void RunController::doWriteAccumulators(
+    int i_runId,
+    IDbExec * i_dbExec,
+    const RunOptions & i_runOpts,
+    const char * i_name,
+    size_t i_size,
+    size_t i_count,
+    size_t i_pageSize,
+    const double * const * i_pages,
+    const double * i_fill
+) const
 {
     // find output table db row and accumulators
     const TableDicRow * tblRow = metaStore->tableDic->byModelIdName(modelId, i_name);
@@ -326,15 +364,100 @@ void RunController::doWriteAccumulators(
             i_runOpts.nullValue
         ));
 
-        for (const auto & apc : io_accValues) {
+        size_t pageCount = (i_size + i_pageSize - 1) / i_pageSize;
+
+        for (size_t k = 0; k < i_count; k++) {
             writer->writeAccumulator(
-                i_dbExec, i_runOpts.subValueId, metaStore->tableAcc->byIndex(nAcc)->accId, i_size, apc.get()
+                i_dbExec,
+                i_runOpts.subValueId,
+                metaStore->tableAcc->byIndex(nAcc)->accId,
+                i_size,
+                i_pageSize,
+                i_pages + k * pageCount,
+                i_fill != nullptr ? i_fill[k] : numeric_limits<double>::quiet_NaN()
             );
             nAcc++;
         }
     }
 }
 
+/** write output table accumulators stored in a single block or send data to root process.
+*
+* @param[in]     i_runOpts      model run options
+* @param[in]     i_isLastTable  if true then it is last output table to write
+* @param[in]     i_name         output table name
+* @param[in]     i_size         number of cells for each accumulator
+* @param[in]     i_count        number of accumulators
+* @param[in]     i_stride       number of values from the start of one accumulator to the start of the next
+* @param[in]     i_block        accumulator values
+*
+* Each accumulator is written as a single page of i_size cells.
+*/
+void RunController::writeAccumulators(
+    const RunOptions & i_runOpts,
+    bool i_isLastTable,
+    const char * i_name,
+    size_t i_size,
+    size_t i_count,
+    size_t i_stride,
+    const double * i_block
+    )
+{
+    vector<const double *> accPages;
+    for (size_t k = 0; k < i_count; k++) {
+        accPages.push_back(i_block + k * i_stride);
+    }
+    writeAccumulators(i_runOpts, i_isLastTable, i_name, i_size, i_count, i_size, accPages.data(), nullptr);
+}
+
+/** write output table accumulators stored in pages or send data to root process.
+*
+* @param[in]     i_runOpts      model run options
+* @param[in]     i_isLastTable  if true then it is last output table to write
+* @param[in]     i_name         output table name
+* @param[in]     i_size         number of cells for each accumulator
+* @param[in]     i_count        number of accumulators
+* @param[in]     i_pageSize     number of cells in each page
+* @param[in]     i_pages        pages of accumulator values: i_count accumulators of ceil(i_size / i_pageSize) pages each
+* @param[in]     i_fill         value of the cells of a NULL page for each accumulator, can be NULL if there are no NULL pages
+*
+* This default implementation copies accumulators into separate arrays, 
+* as required to send them to root process, and writes that list of arrays.
+*/
+void RunController::writeAccumulators(
+    const RunOptions & i_runOpts,
+    bool i_isLastTable,
+    const char * i_name,
+    size_t i_size,
+    size_t i_count,
+    size_t i_pageSize,
+    const double * const * i_pages,
+    const double * i_fill
+    )
+{
+    size_t pageCount = (i_size + i_pageSize - 1) / i_pageSize;
+
+    forward_list<unique_ptr<double[]> > accValues;
+    auto it = accValues.before_begin();
+    for (size_t k = 0; k < i_count; k++) {
+        it = accValues.insert_after(it, unique_ptr<double[]>(new double[i_size]));
+
+        for (size_t nPage = 0; nPage < pageCount; nPage++) {
+            const double * pageArr = i_pages[k * pageCount + nPage];
+            double * dst = it->get() + nPage * i_pageSize;
+            size_t n = min(i_pageSize, i_size - nPage * i_pageSize);
+
+            if (pageArr != nullptr) {
+                copy(pageArr, pageArr + n, dst);
+            }
+            else {
+                fill(dst, dst + n, i_fill[k]);
+            }
+        }
+    }
+    writeAccumulators(i_runOpts, i_isLastTable, i_name, i_size, accValues);
+}
+
 /** update sub-value index to restart the run */
 void RunController::updateRestartSubValueId(int i_runId, IDbExec * i_dbExec, int i_subRestart) const
 {
@@ -53,6 +53,21 @@ namespace openm
             forward_list<unique_ptr<double[]> > & io_accValues
             ) override;
 
+        /** write output table accumulators stored in pages. */
+        virtual void writeAccumulators(
+            const RunOptions & i_runOpts,
+            bool i_isLastTable,
+            const char * i_name,
+            size_t i_size,
+            size_t i_count,
+            size_t i_pageSize,
+            const double * const * i_pages,
+            const double * i_fill
+            ) override;
+
+        /** write output table accumulators stored in a single block as pages. */
+        using RunController::writeAccumulators;
+
         /** model run shutdown: save results and update run status. */
         virtual void shutdownRun(int i_runId) override { doShutdownRun(i_runId, taskRunId, dbExec); }
 
@@ -122,6 +137,21 @@ namespace openm
             forward_list<unique_ptr<double[]> > & io_accValues
             ) override;
 
+        /** write output table accumulators stored in pages. */
+        virtual void writeAccumulators(
+            const RunOptions & i_runOpts,
+            bool i_isLastTable,
+            const char * i_name,
+            size_t i_size,
+            size_t i_count,
+            size_t i_pageSize,
+            const double * const * i_pages,
+            const double * i_fill
+            ) override;
+
+        /** write output table accumulators stored in a single block as pages. */
+        using RunController::writeAccumulators;
+
         /** model run shutdown: save results and update run status. */
         virtual void shutdownRun(int i_runId) override;
 
@@ -266,6 +296,9 @@ namespace openm
             forward_list<unique_ptr<double[]> > & io_accValues
             ) override;
 
+        /** copy accumulators stored in a single block or in pages and send to root process. */
+        using RunController::writeAccumulators;
+
         /** model run shutdown: save results and update run status. */
         virtual void shutdownRun(int i_runId) override;
 
@@ -348,6 +381,21 @@ namespace openm
             forward_list<unique_ptr<double[]> > & io_accValues
             ) override;
 
+        /** write output table accumulators stored in pages. */
+        virtual void writeAccumulators(
+            const RunOptions & i_runOpts,
+            bool i_isLastTable,
+            const char * i_name,
+            size_t i_size,
+            size_t i_count,
+            size_t i_pageSize,
+            const double * const * i_pages,
+            const double * i_fill
+            ) override;
+
+        /** write output table accumulators stored in a single block as pages. */
+        using RunController::writeAccumulators;
+
         /** model run shutdown: save results and update run status. */
         virtual void shutdownRun(int i_runId) override { doShutdownRun(i_runId, 0, dbExec); }
 
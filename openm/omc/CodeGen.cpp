@@ -153,6 +153,10 @@ void CodeGen::do_preamble()
         c += "#include <csignal>";
         c += "#endif";
     }
+    if ((Symbol::option_resource_use && Symbol::option_resource_use_timing > 0) || Symbol::option_member_profile) {
+        c += "// For event timing or member profile csv";
+        c += "#include <fstream>";
+    }
     c += "";
 
     // control warnings produced in generated code
@@ -213,6 +217,39 @@ void CodeGen::do_preamble()
         t0 += "";
     }
 
+    if (Symbol::option_event_queue == Symbol::event_queue_method::heap) {
+        t0 += doxygen_short("Model was built with event_queue = heap.");
+        t0 += "constexpr bool om_event_queue_heap = true;";
+        t0 += "";
+    }
+    else {
+        t0 += doxygen_short("Model was built with event_queue other than heap.");
+        t0 += "constexpr bool om_event_queue_heap = false;";
+        t0 += "";
+    }
+
+    if (Symbol::option_event_queue == Symbol::event_queue_method::calendar) {
+        t0 += doxygen_short("Model was built with event_queue = calendar.");
+        t0 += "constexpr bool om_event_queue_calendar = true;";
+        t0 += "";
+    }
+    else {
+        t0 += doxygen_short("Model was built with event_queue other than calendar.");
+        t0 += "constexpr bool om_event_queue_calendar = false;";
+        t0 += "";
+    }
+
+    if (Symbol::option_event_queue == Symbol::event_queue_method::lazy) {
+        t0 += doxygen_short("Model was built with event_queue = lazy.");
+        t0 += "constexpr bool om_event_queue_lazy = true;";
+        t0 += "";
+    }
+    else {
+        t0 += doxygen_short("Model was built with event_queue other than lazy.");
+        t0 += "constexpr bool om_event_queue_lazy = false;";
+        t0 += "";
+    }
+
     if (Symbol::option_weighted_tabulation) {
         t0 += doxygen_short("Model was built with weighted_tabulation = on.");
         t0 += "constexpr bool om_weighted_tabulation_on = true;";
@@ -235,6 +272,56 @@ void CodeGen::do_preamble()
         t0 += "";
     }
 
+    if (Symbol::option_batched_aging) {
+        t0 += doxygen_short("Model was built with batched_aging = on.");
+        t0 += "constexpr bool om_batched_aging_on = true;";
+        t0 += "";
+    }
+    else {
+        t0 += doxygen_short("Model was built with batched_aging = off.");
+        t0 += "constexpr bool om_batched_aging_on = false;";
+        t0 += "";
+    }
+
+    {
+        size_t k = Symbol::option_quantile_sketch;
+        t0 += doxygen_short("Observation collections in entity tables are quantile sketches (quantile_sketch).");
+        t0 += "constexpr bool om_quantile_sketch_on = " + std::string(k > 0 ? "true" : "false") + ";";
+        t0 += doxygen_short("Capacity of quantile sketches (quantile_sketch), which controls accuracy.");
+        t0 += "constexpr int om_quantile_sketch_k = " + std::to_string(k > 0 ? k : 200) + ";";
+        t0 += "";
+    }
+
+    if (Symbol::option_random_normal_ziggurat) {
+        t0 += doxygen_short("Model was built with random_normal = ziggurat.");
+        t0 += "constexpr bool om_random_normal_ziggurat = true;";
+        t0 += "";
+    }
+    else {
+        t0 += doxygen_short("Model was built with random_normal = polar.");
+        t0 += "constexpr bool om_random_normal_ziggurat = false;";
+        t0 += "";
+    }
+
+    if (Symbol::option_member_profile) {
+        t0 += doxygen_short("Model was built with member_profile = on.");
+        t0 += "constexpr bool om_member_profile_on = true;";
+        t0 += "";
+    }
+    else {
+        t0 += doxygen_short("Model was built with member_profile = off.");
+        t0 += "constexpr bool om_member_profile_on = false;";
+        t0 += "";
+    }
+
+    {
+        // timing of event functions is part of resource use
+        size_t interval = Symbol::option_resource_use ? Symbol::option_resource_use_timing : 0;
+        t0 += doxygen_short("Sampling interval for timing of event functions (resource_use_timing), 0 if off.");
+        t0 += "constexpr size_t om_resource_use_timing = " + std::to_string(interval) + ";";
+        t0 += "";
+    }
+
     if (Symbol::option_event_trace) {
         t0 += doxygen_short("Model was built with event trace capability.");
         t0 += "constexpr bool om_event_trace_capable = true;";
@@ -950,12 +1037,17 @@ void CodeGen::do_RunInit()
         c += "";
     }
     c += "extern void process_trace_options(IRunBase* const i_runBase);";
+    c += "extern void process_checkpoint_options(IRunBase* const i_runBase);";
     c += "extern int64_t report_parameter_read_progress(int paramNumber, int paramCount, const char * name, int64_t lastTime);";
     c += "";
     c += "// Process model dev options for EventTrace";
     if (Symbol::option_checkpoints) c += "CHECKPOINT(\"checkpoint: Call process_trace_options\");";
     c += "process_trace_options(i_runBase);";
     c += "";
+    c += "// Process model dev options for Checkpoint";
+    if (Symbol::option_checkpoints) c += "CHECKPOINT(\"checkpoint: Call process_checkpoint_options\");";
+    c += "process_checkpoint_options(i_runBase);";
+    c += "";
     c += "theLog->logMsg(\"Get scenario parameters for process\");";
     c += "";
     c += "int64_t last_progress_ms = getMilliseconds();";
@@ -1240,14 +1332,14 @@ void CodeGen::do_ModelStartup()
         if (Symbol::option_checkpoints) c += "CHECKPOINT(\"checkpoint: Allocate memory for '" + es->name + "'\");";
         if (es->dimension_count() == 0) {
             c += "assert(!" + es->name + ");";
-            c += es->name + " = new EntitySet<" + es->pp_entity->name + ">;";
+            c += es->name + " = new EntitySet<" + es->pp_entity->name + ">" + es->cxx_constructor_args() + ";";
         }
         else {
             c += "EntitySet<" + es->pp_entity->name + "> ** flattened_array = reinterpret_cast<EntitySet<" + es->pp_entity->name + "> **>(" + es->name + ");";
             c += "const size_t cells = " + to_string(es->cell_count()) + ";";
             c += "for (size_t cell = 0; cell < cells; ++cell) {";
             c += "assert(!flattened_array[cell]);";
-            c += "flattened_array[cell] = new EntitySet<" + es->pp_entity->name + ">;";
+            c += "flattened_array[cell] = new EntitySet<" + es->pp_entity->name + ">" + es->cxx_constructor_args() + ";";
             c += "}";
         }
         c += "}";
@@ -1341,8 +1433,16 @@ void CodeGen::do_ModelShutdown()
             c += "if (!is_suppressed_write(\"" + table->name + "\", i_model)) {";
             c += "last_progress_ms = report_table_write_progress(simulation_member, ++n_table, \"" + table->name + "\", last_progress_ms);";
             if (Symbol::option_checkpoints) c += "CHECKPOINT(\"checkpoint: Write '" + table->name + "'\");";
-            c += "i_model->writeOutputTable(\"" +
-                table->name + "\", " + table->cxx_instance + "->n_cells, " + table->cxx_instance + "->acc_storage);";
+            if (table->is_sparse) {
+                // pages never touched are not materialized
+                c += "i_model->writeOutputTable(\"" +
+                    table->name + "\", " + table->cxx_instance + "->n_cells, " + table->cxx_instance + "->n_accumulators, " + table->cxx_instance + "->page_size, " + table->cxx_instance + "->acc_pages().data(), " + table->cxx_instance + "->acc_fill_values().data());";
+            }
+            else {
+                c += "i_model->writeOutputTable(\"" +
+                    table->name + "\", " + table->cxx_instance + "->n_cells, " + table->cxx_instance + "->n_accumulators, " + table->cxx_instance + "->cell_stride, " + table->cxx_instance + "->acc_block.get());";
+            }
+            c += table->cxx_instance + "->release_accumulators();";
             c += "}";
         }
     }
@@ -1359,7 +1459,10 @@ void CodeGen::do_ModelShutdown()
             c += " i_model->writeOutputTable(\"" +
                 derived_table->name + "\", " +
                 derived_table->cxx_instance + "->n_cells, " +
-                derived_table->cxx_instance + "->measure_storage);";
+                derived_table->cxx_instance + "->n_measures, " +
+                derived_table->cxx_instance + "->cell_stride, " +
+                derived_table->cxx_instance + "->measure_block.get());";
+            c += derived_table->cxx_instance + "->measure_block.reset();";
             c += "}";
         }
     }
@@ -1529,6 +1632,31 @@ void CodeGen::do_entities()
             h += "";
         }
 
+        if (Symbol::option_batched_aging) {
+            h += doxygen_short("The position of this entity in om_kind_entities");
+            h += "size_t om_kind_registry_index;";
+            h += "";
+            h += "typedef dense_registry<" + entity->name + ", &" + entity->name + "::om_kind_registry_index> om_kind_registry_type;";
+            h += "";
+            h += doxygen_short("Active entities of this kind, most recently activated first (batched_aging = on)");
+            h += "inline static thread_local om_kind_registry_type *om_kind_entities = nullptr;";
+            h += "";
+            h += doxygen_short("Add the entity to the list of active entities of its kind");
+            h += "void om_make_active_kind() override";
+            h += "{";
+            h +=     "assert(om_kind_entities);";
+            h +=     "om_kind_entities->insert(this);";
+            h += "}";
+            h += "";
+            h += doxygen_short("Remove the entity from the list of active entities of its kind");
+            h += "void om_make_inactive_kind() override";
+            h += "{";
+            h +=     "assert(om_kind_entities);";
+            h +=     "om_kind_entities->erase(this);";
+            h += "}";
+            h += "";
+        }
+
         h += "//";
 	    h += "// function members in " + entity->name + " entity";
 	    h += "//";
@@ -1608,7 +1736,107 @@ void CodeGen::do_entities()
 	    h += "// Data members in " + entity->name + " entity";
 	    h += "//";
 	    h += "";
-        if (Symbol::option_entity_member_packing) {
+        if (Symbol::member_profile.count(entity->name)) {
+            // lay out data members using the member profile from a run with member_profile = on
+            auto& profile = Symbol::member_profile[entity->name];
+            // tier 0 is accessed attributes, tier 1 is members without access counts, tier 2 is attributes never accessed
+            auto tier = [&profile](EntityDataMemberSymbol* dm) {
+                auto it = profile.find(dm->name);
+                if (it == profile.end() || !it->second.has_accesses) return 1;
+                return (it->second.accesses > 0) ? 0 : 2;
+            };
+            auto accesses = [&profile](EntityDataMemberSymbol* dm) {
+                auto it = profile.find(dm->name);
+                return (it == profile.end()) ? 0.0 : it->second.accesses;
+            };
+            // create a temporary copy of the list of data members in the entity
+            auto lst = entity->pp_data_members;
+            // sort it in ascending order of tier,
+            // in descending order of accesses within tier 0,
+            // in ascending order of layout group within tier 1,
+            // and lexicographically otherwise
+            lst.sort([&](EntityDataMemberSymbol* a, EntityDataMemberSymbol* b)
+                {
+                    int ta = tier(a);
+                    int tb = tier(b);
+                    if (ta != tb) return ta < tb;
+                    if (ta == 0 && accesses(a) != accesses(b)) return accesses(a) > accesses(b);
+                    if (ta == 1 && a->layout_group() != b->layout_group()) return a->layout_group() < b->layout_group();
+                    return a->name < b->name;
+                }
+            );
+
+            // Report cache lines spanned by data members, in the profiled layout (before) and this layout (after),
+            // assuming that the entity starts on a cache line boundary.
+            {
+                const size_t line_size = 64;
+                set<size_t> hot_before, all_before, hot_after, all_after;
+                auto add_lines = [line_size](set<size_t>& lines, size_t offset, size_t size) {
+                    for (size_t ln = offset / line_size; size > 0 && ln <= (offset + size - 1) / line_size; ++ln) {
+                        lines.insert(ln);
+                    }
+                };
+                size_t start = SIZE_MAX;
+                for (auto& pr : profile) {
+                    start = std::min(start, pr.second.offset);
+                }
+                size_t offset = start;
+                int hot_count = 0;
+                int unknown_count = 0;
+                for (auto dm : lst) {
+                    auto it = profile.find(dm->name);
+                    if (it == profile.end()) {
+                        // member not in profile, e.g. profile is out of date
+                        ++unknown_count;
+                        continue;
+                    }
+                    auto& info = it->second;
+                    size_t align = std::max<size_t>(info.alignment, 1);
+                    offset = (offset + align - 1) / align * align;
+                    bool is_hot = tier(dm) == 0;
+                    add_lines(all_before, info.offset, info.size);
+                    add_lines(all_after, offset, info.size);
+                    if (is_hot) {
+                        ++hot_count;
+                        add_lines(hot_before, info.offset, info.size);
+                        add_lines(hot_after, offset, info.size);
+                    }
+                    offset += info.size;
+                }
+                theLog->logFormatted(
+                    "Member layout of %s from profile: %d of %d members accessed, spanning %d cache lines (before %d), all members span %d cache lines (before %d)",
+                    entity->name.c_str(),
+                    hot_count,
+                    (int)lst.size(),
+                    (int)hot_after.size(),
+                    (int)hot_before.size(),
+                    (int)all_after.size(),
+                    (int)all_before.size()
+                );
+                if (unknown_count > 0) {
+                    theLog->logFormatted("Warning : %d members of %s are not in the member profile", unknown_count, entity->name.c_str());
+                }
+            }
+
+            // iterate the sorted list and generate declaration h and definition c
+            int tier_current = -1; // a value less than any tier
+            for (auto data_member : lst) {
+                int tier_this = tier(data_member);
+                if (tier_this > tier_current) {
+                    tier_current = tier_this;
+                    h += "";
+                    h += "//////////////////////////////////////////////";
+                    h += (tier_current == 0) ? "// Profile: accessed attributes" :
+                         (tier_current == 1) ? "// Profile: other members" :
+                                               "// Profile: attributes not accessed";
+                    h += "//////////////////////////////////////////////";
+                    h += "";
+                }
+                h += data_member->cxx_declaration_entity();
+                c += data_member->cxx_definition_entity();
+            }
+        }
+        else if (Symbol::option_entity_member_packing) {
             // create a temporary copy of the list of data members in the entity
             auto lst = entity->pp_data_members;
             // sort it in descending order of alignment_size
@@ -1851,13 +2079,44 @@ void CodeGen::do_entities()
     c += "}";
     c += "";
 
+    c += doxygen("Age all entities to the given time, one kind of entity at a time");
+    c += "void BaseEntity::age_all_entities_batched(Time t, int originating_entity_id, int originating_event_id)";
+    c += "{";
+    if (Symbol::option_batched_aging) {
+        for (auto entity : Symbol::pp_all_entities) {
+            // Qualified calls of member functions of the entity kind are not virtual and can be inlined.
+            c += "// " + entity->name;
+            c += "assert(" + entity->name + "::om_kind_entities);";
+            c += entity->name + "::om_kind_entities->for_each([&](" + entity->name + " *entity) {";
+            c += "if (entity->" + entity->name + "::om_get_entity_id() == originating_entity_id) {";
+            c += "// This is the entity within which the event occurred.";
+            c += "// Check for time running backwards in the entity within which the event occurred";
+            c += "if (t < entity->" + entity->name + "::om_get_time()) {";
+            c += "handle_backwards_time(entity->" + entity->name + "::om_get_time(), t, originating_event_id, originating_entity_id);";
+            c += "}";
+            c += "}";
+            c += "entity->" + entity->name + "::age_entity(t);";
+            c += "});";
+        }
+    }
+    else {
+        c += "// not used (batched_aging = off)";
+        c += "assert(false);";
+    }
+    c += "}";
+    c += "";
+
     c += "void BaseEntity::initialize_simulation_runtime()";
     c += "{";
-    c += "entities = new std::list<BaseEntity *>;";
+    c += "entities = new registry_type;";
     for ( auto ent : Symbol::pp_all_entities ) {
         // e.g. Person::zombies = new forward_list<Person *>;";
         c += ent->name + "::zombies = new std::forward_list<" + ent->name + " *>;";
         c += ent->name + "::available = new std::forward_list<" + ent->name + " *>;";
+        c += ent->name + "::slab = new slab_allocator<" + ent->name + ">;";
+        if (Symbol::option_batched_aging) {
+            c += ent->name + "::om_kind_entities = new " + ent->name + "::om_kind_registry_type;";
+        }
         c += "";
         c += "// reset resource use information for " + ent->name;
         c += ent->name + "::resource_use_reset();";
@@ -1892,6 +2151,15 @@ void CodeGen::do_entities()
         c += "}";
         c += "delete " + entity->name + "::available;";
         c += entity->name + "::available = nullptr;";
+        if (Symbol::option_batched_aging) {
+            c += "assert(" + entity->name + "::om_kind_entities->empty());";
+            c += "delete " + entity->name + "::om_kind_entities;";
+            c += entity->name + "::om_kind_entities = nullptr;";
+        }
+        c += "";
+        c += "// release storage of all entities of this kind";
+        c += "delete " + entity->name + "::slab;";
+        c += entity->name + "::slab = nullptr;";
         c += "";
     }
     c += "}";
@@ -2072,6 +2340,35 @@ void CodeGen::do_table_interface()
     c += "}";
     c += "return nullptr;";
     c += "}";
+    c += "";
+
+    c += "void om_checkpoint_write_tables(std::ostream& os)";
+    c += "{";
+    c += "checkpoint_put(os, (int32_t)" + to_string(Symbol::pp_all_entity_tables.size()) + ");";
+    for (auto table : Symbol::pp_all_entity_tables) {
+        // a suppressed table has no instance, and is recorded as absent
+        c += "checkpoint_put(os, (int32_t)" + to_string(table->pp_table_id) + ");";
+        c += "checkpoint_put(os, (bool)" + table->cxx_instance + ");";
+        c += "if (" + table->cxx_instance + ") " + table->cxx_instance + "->write_checkpoint(os);";
+    }
+    c += "}";
+    c += "";
+
+    c += "bool om_checkpoint_read_tables(std::istream& is)";
+    c += "{";
+    c += "int32_t n_tables = 0;";
+    c += "checkpoint_get(is, n_tables);";
+    c += "if (!is || n_tables != " + to_string(Symbol::pp_all_entity_tables.size()) + ") return false;";
+    c += "int32_t table_id = 0;";
+    c += "bool is_present = false;";
+    for (auto table : Symbol::pp_all_entity_tables) {
+        c += "checkpoint_get(is, table_id);";
+        c += "checkpoint_get(is, is_present);";
+        c += "if (!is || table_id != " + to_string(table->pp_table_id) + " || is_present != (bool)" + table->cxx_instance + ") return false;";
+        c += "if (" + table->cxx_instance + " && !" + table->cxx_instance + "->read_checkpoint(is)) return false;";
+    }
+    c += "return (bool)is;";
+    c += "}";
     c += "";
 
 	c += "";
@@ -2083,10 +2380,10 @@ void CodeGen::do_event_queue()
     c += "// Definitions of static members of BaseEvent (declaration in Event.h)";
     c += "";
     c += "// definition of event_queue (declaration in Event.h)";
-    c += "thread_local std::set<BaseEvent *, less_deref<BaseEvent *> > *BaseEvent::event_queue = nullptr;";
+    c += "thread_local BaseEvent::event_queue_type *BaseEvent::event_queue = nullptr;";
     c += "";
     c += "// definition of dirty_events (declaration in Event.h)";
-    c += "thread_local std::set<BaseEvent *, decltype(BaseEvent::dirty_cmp)* > *BaseEvent::dirty_events = nullptr;";
+    c += "thread_local std::vector<BaseEvent *> *BaseEvent::dirty_events = nullptr;";
     c += "";
     c += "// definition of global_event_counter (declaration in Event.h)";
     c += "thread_local big_counter BaseEvent::global_event_counter;";
@@ -2095,7 +2392,7 @@ void CodeGen::do_event_queue()
     c += "thread_local Time *BaseEvent::global_time = nullptr;";
     c += "";
     c += "// definition of active entity list (declaration in Entity.h)";
-    c += "thread_local std::list<BaseEntity *> *BaseEntity::entities = nullptr;";
+    c += "thread_local BaseEntity::registry_type *BaseEntity::entities = nullptr;";
     c += "";
     c += "// definition of event_id of current event (declaration in Event.h)";
     c += "thread_local int BaseEvent::current_event_id;";
@@ -2264,6 +2561,69 @@ void CodeGen::do_RunModel()
     c += "RunSimulation(sub_id, sub_count, i_model); // Defined by the model framework, generally in a 'use' module";
     if (Symbol::option_checkpoints) c += "CHECKPOINT(\"checkpoint: Returned from RunSimulation\");";
     c += "";
+    if (Symbol::option_resource_use && Symbol::option_resource_use_timing > 0) {
+        // each member writes its own csv file, which avoids synchronization among members
+        c += "{";
+        c += "// Event timing for this member, in csv format";
+        c += "std::string timing_file_name = std::string(OM_MODEL_NAME) + \".event_timing.\" + std::to_string(sub_id) + \".csv\";";
+        c += "std::ofstream timing_csv(timing_file_name, std::ios_base::out | std::ios_base::trunc);";
+        c += "if (timing_csv.is_open()) {";
+        c += "timing_csv << \"member,entity,event,time_calculations,occurrences,time_func_samples,implement_func_samples,time_func_seconds,implement_func_seconds\\n\";";
+        c += "timing_csv.precision(9);";
+        for (auto ent : Symbol::pp_all_entities) {
+            for (auto evt : ent->pp_events) {
+                c += "{";
+                c += "auto evt_result = " + ent->name + "::om_null_entity." + evt->name + ".resource_use();";
+                c += "timing_csv << sub_id << \"," + ent->name + "," + evt->event_name + ",\"";
+                c += "    << evt_result.time_calculations << ',' << evt_result.occurrences << ','";
+                c += "    << evt_result.time_func_samples << ',' << evt_result.implement_func_samples << ','";
+                c += "    << evt_result.time_func_seconds << ',' << evt_result.implement_func_seconds << '\\n';";
+                c += "}";
+            }
+        }
+        c += "theLog->logFormatted(\"member=%d Event timing written to %s\", sub_id, timing_file_name.c_str());";
+        c += "}";
+        c += "else {";
+        c += "theLog->logFormatted(\"Warning : unable to write event timing to %s\", timing_file_name.c_str());";
+        c += "}";
+        c += "}";
+    }
+    if (Symbol::option_member_profile) {
+        // each member writes its own csv file, which avoids synchronization among members
+        c += "{";
+        c += "// Entity member profile for this member, in csv format, for omc option Omc.MemberProfile";
+        c += "std::string profile_file_name = std::string(OM_MODEL_NAME) + \".member_profile.\" + std::to_string(sub_id) + \".csv\";";
+        c += "std::ofstream profile_csv(profile_file_name, std::ios_base::out | std::ios_base::trunc);";
+        c += "if (profile_csv.is_open()) {";
+        c += "profile_csv << \"entity,member,accesses,offset,size,alignment\\n\";";
+        for (auto ent : Symbol::pp_all_entities) {
+            c += "{";
+            c += "auto& ent = " + ent->name + "::om_null_entity;";
+            for (auto dm : ent->pp_data_members) {
+                c += "profile_csv << \"" + ent->name + "," + dm->name + ",\"";
+                if (dm->is_attribute()) {
+                    c += "    << ent." + dm->name + ".access_count";
+                }
+                c += "    << ',' << ((char *)&ent." + dm->name + " - (char *)&ent)";
+                c += "    << ',' << sizeof(ent." + dm->name + ") << ',' << alignof(decltype(ent." + dm->name + ")) << '\\n';";
+            }
+            c += "}";
+        }
+        c += "theLog->logFormatted(\"member=%d Entity member profile written to %s\", sub_id, profile_file_name.c_str());";
+        c += "}";
+        c += "else {";
+        c += "theLog->logFormatted(\"Warning : unable to write entity member profile to %s\", profile_file_name.c_str());";
+        c += "}";
+        c += "}";
+        c += "// reset access counts, so that the profile of the next member on this thread is its own";
+        for (auto ent : Symbol::pp_all_entities) {
+            for (auto dm : ent->pp_data_members) {
+                if (dm->is_attribute()) {
+                    c += ent->name + "::om_null_entity." + dm->name + ".access_count = 0;";
+                }
+            }
+        }
+    }
     c += "";
     if (Symbol::option_resource_use) {
         // do not generate code for resource report unless requested
@@ -2284,7 +2644,9 @@ void CodeGen::do_RunModel()
         c += "auto prefix3 = prefix3s.c_str();";
         c += "auto dashes = dashes_str.c_str();";
         c += "auto stars = stars_str.c_str();";
-        c += "int set_node_bytes = 4 * sizeof(void *); // assume 3 words for b-tree, plus 1 word for payload (pointer)";
+        c += "// heap or calendar: 1 word for payload (pointer), set: assume 3 words for b-tree, plus 1 word for payload (pointer)";
+        c += "// lazy: 4 words for time, order key, payload (pointer) and generation, not including tombstones";
+        c += "int set_node_bytes = (om_event_queue_heap || om_event_queue_calendar) ? sizeof(void *) : 4 * sizeof(void *);";
         c += "int rb_node_bytes = sizeof(rb_node<void *>);";
         c += "theLog->logFormatted(\"Warning : Model built with resource_use = on\");";
         c += "theLog->logFormatted(\"%sResource Use Report - Begin (for sub/member/replicate %d)\", prefix0, sub_id);";
@@ -2511,6 +2873,31 @@ void CodeGen::do_RunModel()
             c += "}";
         }
 
+        if (Symbol::option_event_queue == Symbol::event_queue_method::lazy) {
+            c += "{ // event queue";
+            c += "auto section_title = \"*  Resource Use Detail for Event Queue  *\";";
+            c += "theLog->logFormatted(\"%s%.*s\", prefix1, strlen(section_title), stars);";
+            c += "theLog->logFormatted(\"%s%s\", prefix1, section_title);";
+            c += "theLog->logFormatted(\"%s%.*s\", prefix1, strlen(section_title), stars);";
+            c += "theLog->logFormatted(\"%s\", prefix1);";
+            c += "auto queue_result = BaseEvent::event_queue->resource_use();";
+            c += "auto table_title = \"    Event Queue (lazy)\";";
+            c += "auto row_sep =         \"+----------------------+--------------+\";";
+            c += "int table_width = (int)strlen(row_sep);";
+            c += "theLog->logFormatted(\"%s+%.*s+\", prefix2, table_width - 2, dashes);";
+            c += "theLog->logFormatted(\"%s| %-*s |\", prefix2, table_width - 4, table_title);";
+            c += "theLog->logFormatted(\"%s%s\", prefix2, row_sep);";
+            c += "theLog->logFormatted(\"%s| Tombstones skipped   | %12d |\", prefix2, (int)queue_result.tombstones_skipped);";
+            c += "theLog->logFormatted(\"%s| Tombstones compacted | %12d |\", prefix2, (int)queue_result.tombstones_compacted);";
+            c += "theLog->logFormatted(\"%s| Compactions          | %12d |\", prefix2, (int)queue_result.compactions);";
+            c += "theLog->logFormatted(\"%s| Max entries          | %12d |\", prefix2, (int)queue_result.max_entries);";
+            c += "theLog->logFormatted(\"%s%s\", prefix2, row_sep);";
+            c += "theLog->logFormatted(\"%s%s\", prefix2, \"Note: entries include tombstones\");";
+            c += "theLog->logFormatted(\"%s\", prefix0);";
+            c += "} // event queue";
+            c += "";
+        }
+
         for (auto ent : Symbol::pp_all_entities) {
             auto dml = ent->pp_data_members;
             size_t members_count = dml.size();
@@ -2678,6 +3065,45 @@ void CodeGen::do_RunModel()
                 c += "theLog->logFormatted(\"%s\", prefix0);";
                 c += "} // events";
                 c += "";
+                if (Symbol::option_resource_use_timing > 0) {
+                    c += "{ // event timing";
+                    c += "auto table_title = \"    " + ent->name + " Event Timing (1 in " + to_string(Symbol::option_resource_use_timing) + " calls timed)\";";
+                    std::string col1header = "event";
+                    size_t col1width = col1header.length();
+                    for (auto evt : ent->pp_events) { col1width = std::max<size_t>(col1width, evt->event_name.length()); };
+                    c += "int col1width = " + to_string(col1width) + ";";
+                    c += "const char * col1header = \"" + col1header + "\";";
+                    std::string row_sep = "+-" + std::string(col1width, '-') +
+                        "-+--------------+--------------+--------------+--------------+";
+                    c += "auto row_sep = \"" + row_sep + "\";";
+                    c += "int table_width = (int)strlen(row_sep);";
+                    c += "theLog->logFormatted(\"%s+%.*s+\", prefix2, table_width - 2, dashes);";
+                    c += "theLog->logFormatted(\"%s| %-*s |\", prefix2, table_width - 4, table_title);";
+                    c += "theLog->logFormatted(\"%s%s\", prefix2, row_sep);";
+                    c += "theLog->logFormatted(\"%s| %-*s |  time func s |  us per calc | implement s  |  us per occ  |\", prefix2, col1width, col1header);";
+                    c += "theLog->logFormatted(\"%s%s\", prefix2, row_sep);";
+                    c += "double time_func_total = 0;";
+                    c += "double implement_func_total = 0;";
+                    for (auto evt : ent->pp_events) {
+                        c += "{";
+                        c += "// Timing for " + evt->event_name;
+                        c += "auto evt_name = \"" + evt->event_name + "\";";
+                        c += "auto evt_result = " + ent->name + "::om_null_entity." + evt->name + ".resource_use();";
+                        c += "double us_per_calc = evt_result.time_calculations ? 1.0e6 * evt_result.time_func_seconds / (double)evt_result.time_calculations : 0.0;";
+                        c += "double us_per_occ = evt_result.occurrences ? 1.0e6 * evt_result.implement_func_seconds / (double)evt_result.occurrences : 0.0;";
+                        c += "time_func_total += evt_result.time_func_seconds;";
+                        c += "implement_func_total += evt_result.implement_func_seconds;";
+                        c += "theLog->logFormatted(\"%s| %-*s | %12.4f | %12.4f | %12.4f | %12.4f |\", prefix2, col1width, evt_name, evt_result.time_func_seconds, us_per_calc, evt_result.implement_func_seconds, us_per_occ);";
+                        c += "}";
+                    }
+                    c += "theLog->logFormatted(\"%s%s\", prefix2, row_sep);";
+                    c += "theLog->logFormatted(\"%s| %-*s | %12.4f |              | %12.4f |              |\", prefix2, col1width, \"All\", time_func_total, implement_func_total);";
+                    c += "theLog->logFormatted(\"%s%s\", prefix2, row_sep);";
+                    c += "theLog->logFormatted(\"%s%s\", prefix2, \"Note: seconds are estimated from timed calls\");";
+                    c += "theLog->logFormatted(\"%s\", prefix0);";
+                    c += "} // event timing";
+                    c += "";
+                }
             }
             if (ent->pp_sets.size()) {
                 c += "{ // sets";
@@ -108,6 +108,11 @@ void EntityEventSymbol::post_parse(int pass)
             pp_error(LT("error : mismatching arguments in event time function '") + time_func->unique_name + LT("' and event implement function '") + implement_func->unique_name + LT("'"));
         }
 
+        if (event_priority < 0 || event_priority > openm::event_priority_self_scheduling) {
+            // priority is packed into 8 bits of the event ordering key at run-time, see BaseEvent::make_order_key
+            pp_error(LT("error : event priority '") + to_string(event_priority) + LT("' is invalid - must be between 0 and ") + to_string(openm::event_priority_self_scheduling));
+        }
+
         // Now record the conclusion of the preceding chunk of code.
         event_memory = time_func_memory;
 
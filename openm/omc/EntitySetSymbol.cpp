@@ -75,6 +75,23 @@ void EntitySetSymbol::create_auxiliary_symbols()
     }
 }
 
+void EntitySetSymbol::set_unordered()
+{
+    assert(!unordered_index); // grammar guarantee
+    auto *typ = NumericSymbol::find(token::TK_int);
+    assert(typ); // initialization guarantee
+    unordered_index = new EntityInternalSymbol("om_" + name + "_index", entity, typ);
+    unordered_index->provenance = name + " (position in unordered entity set)";
+}
+
+std::string EntitySetSymbol::cxx_constructor_args() const
+{
+    if (unordered_index) {
+        return "(&" + pp_entity->name + "::" + unordered_index->name + ")";
+    }
+    return "";
+}
+
 void EntitySetSymbol::post_parse(int pass)
 {
     // Hook into the post_parse hierarchical calling chain
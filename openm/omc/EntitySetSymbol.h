@@ -44,6 +44,7 @@ public:
         , filter(nullptr)
         , order(nullptr)
         , pp_order_attribute(nullptr)
+        , unordered_index(nullptr)
         , pp_entity_set_id(0)
         , resource_use_gfn(nullptr)
         , resource_use_reset_gfn(nullptr)
@@ -80,6 +81,18 @@ public:
      */
     void build_body_erase();
 
+    /**
+     * Declare the entity set unordered.
+     * 
+     * Creates the entity member which holds the position of the entity in the entity set.
+     */
+    void set_unordered();
+
+    /**
+     * C++ arguments of the constructor of each EntitySet instance.
+     */
+    std::string cxx_constructor_args() const;
+
     /**
      * The number of dimensions in the entity set (rank).
      *
@@ -151,6 +164,13 @@ public:
     */
     AttributeSymbol* pp_order_attribute;
 
+    /**
+     * The entity member which holds the position of the entity in an unordered entity set.
+     * 
+     * Is nullptr if the entity set is ordered.
+     */
+    EntityInternalSymbol* unordered_index;
+
     /**
     * Unique numeric id for the entity set
     */
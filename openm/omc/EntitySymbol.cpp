@@ -1016,6 +1016,7 @@ void EntitySymbol::build_body_initialize_events()
     CodeBlock& c = initialize_events_fn->func_body;
 
     for ( auto event : pp_events ) {
+        c += event->name + ".initialize_order_key();";
         c += event->name + ".make_dirty();";
     }
 
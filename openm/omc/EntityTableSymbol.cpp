@@ -6,6 +6,7 @@
 // This code is licensed under the MIT license (see LICENSE.txt for details)
 
 #include <cassert>
+#include <set>
 #include "EntityTableSymbol.h"
 #include "LanguageSymbol.h"
 #include "EntitySymbol.h"
@@ -353,7 +354,8 @@ CodeBlock EntityTableSymbol::cxx_declaration_global()
         + (pp_has_sumweight ? "true" : "false") + ", "
         + to_string(n_collections) + ", "
         + to_string(n_extras) + ", "
-        + to_string(n_extremas)
+        + to_string(n_extremas) + ", "
+        + (is_sparse ? "true" : "false")
         + ">";
     h += "class " + cxx_class + " final : public " + cxx_template;
     h += "{";
@@ -458,8 +460,14 @@ CodeBlock EntityTableSymbol::cxx_definition_global()
             assert(acc->pp_attribute);
             c += "// " + Symbol::token_to_string(acc->statistic) + "(" + Symbol::token_to_string(acc->increment) + "(" + acc->pp_attribute->name + "))";
         }
-        // e.g. for ( int cell = 0; cell < n_cells; cell++ ) acc[0][cell] =   0.0;
-        c += "for ( int cell = 0; cell < n_cells; cell++ ) acc[" + to_string(acc->index) + "][cell] = " + initial_value + ";";
+        if (is_sparse) {
+            // e.g. acc[0].reset(  0.0);
+            c += "acc[" + to_string(acc->index) + "].reset(" + initial_value + ");";
+        }
+        else {
+            // e.g. for ( int cell = 0; cell < n_cells; cell++ ) acc[0][cell] =   0.0;
+            c += "for ( int cell = 0; cell < n_cells; cell++ ) acc[" + to_string(acc->index) + "][cell] = " + initial_value + ";";
+        }
         c += "";
 
     }
@@ -472,8 +480,14 @@ CodeBlock EntityTableSymbol::cxx_definition_global()
     c += "assert(" + cxx_instance + "); // unitary table must be instantiated";
     c += "";
 
-    c += "// process each cell";
-    c += "for (int cell = 0; cell < n_cells; ++cell) {";
+    if (is_sparse) {
+        c += "// extract the accumulators of a cell";
+        c += "auto extract_cell = [&](int cell) {";
+    }
+    else {
+        c += "// process each cell";
+        c += "for (int cell = 0; cell < n_cells; ++cell) {";
+    }
     c += "";
     if (n_collections > 0) {
         c += "// Compute statistics for each observation collection in the cell.";
@@ -514,111 +528,171 @@ CodeBlock EntityTableSymbol::cxx_definition_global()
         c += "P98[j] = UNDEF_VALUE;";
         c += "P99[j] = UNDEF_VALUE;";
         c += "gini[j] = UNDEF_VALUE;";
-        c += "auto &lst = coll[cell][j];";
-        c += "lst.sort();";
-        c += "double total_count = (double)distance(lst.begin(), lst.end());";
-        c += "if (total_count > 0) {";
-        c += "double cum_count = 0.0;";
-        c += "double cum_count_prev = 0.0;";
-        c += "double value_prev = 0.0;";
-        c += "double cum_value = 0.0;";
-        c += "double cum_value_i = 0.0; // sum of rank*value";
-        c += "bool P1_done = false;";
-        c += "bool P2_done = false;";
-        c += "bool P5_done = false;";
-        c += "bool P10_done = false;";
-        c += "bool P20_done = false;";
-        c += "bool P25_done = false;";
-        c += "bool P30_done = false;";
-        c += "bool P40_done = false;";
-        c += "bool P50_done = false;";
-        c += "bool P60_done = false;";
-        c += "bool P70_done = false;";
-        c += "bool P75_done = false;";
-        c += "bool P80_done = false;";
-        c += "bool P90_done = false;";
-        c += "bool P95_done = false;";
-        c += "bool P98_done = false;";
-        c += "bool P99_done = false;";
-        c += "for (auto &value : lst ) {";
-        c += "cum_count += 1.0;";
-        c += "cum_value += value;";
-        c += "cum_value_i += cum_count * value;";
-        c += "if (!P1_done && cum_count >= total_count * 0.01) {";
-        c += "P1[j] = value;";
-        c += "P1_done = true;";
-        c += "}";
-        c += "if (!P2_done && cum_count >= total_count * 0.02) {";
-        c += "P2[j] = value;";
-        c += "P2_done = true;";
-        c += "}";
-        c += "if (!P5_done && cum_count >= total_count * 0.05) {";
-        c += "P5[j] = value;";
-        c += "P5_done = true;";
-        c += "}";
-        c += "if (!P10_done && cum_count >= total_count * 0.10) {";
-        c += "P10[j] = value;";
-        c += "P10_done = true;";
-        c += "}";
-        c += "if (!P20_done && cum_count >= total_count * 0.20) {";
-        c += "P20[j] = value;";
-        c += "P20_done = true;";
-        c += "}";
-        c += "if (!P25_done && cum_count >= total_count * 0.25) {";
-        c += "P25[j] = value;";
-        c += "P25_done = true;";
-        c += "}";
-        c += "if (!P30_done && cum_count >= total_count * 0.30) {";
-        c += "P30[j] = value;";
-        c += "P30_done = true;";
-        c += "}";
-        c += "if (!P40_done && cum_count >= total_count * 0.40) {";
-        c += "P40[j] = value;";
-        c += "P40_done = true;";
-        c += "}";
-        c += "if (!P50_done && cum_count >= total_count * 0.50) {";
-        c += "P50[j] = value;";
-        c += "P50_done = true;";
-        c += "}";
-        c += "if (!P60_done && cum_count >= total_count * 0.60) {";
-        c += "P60[j] = value;";
-        c += "P60_done = true;";
-        c += "}";
-        c += "if (!P70_done && cum_count >= total_count * 0.70) {";
-        c += "P70[j] = value;";
-        c += "P70_done = true;";
-        c += "}";
-        c += "if (!P75_done && cum_count >= total_count * 0.75) {";
-        c += "P75[j] = value;";
-        c += "P75_done = true;";
-        c += "}";
-        c += "if (!P80_done && cum_count >= total_count * 0.80) {";
-        c += "P80[j] = value;";
-        c += "P80_done = true;";
-        c += "}";
-        c += "if (!P90_done && cum_count >= total_count * 0.90) {";
-        c += "P90[j] = value;";
-        c += "P90_done = true;";
-        c += "}";
-        c += "if (!P95_done && cum_count >= total_count * 0.95) {";
-        c += "P95[j] = value;";
-        c += "P95_done = true;";
-        c += "}";
-        c += "if (!P98_done && cum_count >= total_count * 0.98) {";
-        c += "P98[j] = value;";
-        c += "P98_done = true;";
-        c += "}";
-        c += "if (!P99_done && cum_count >= total_count * 0.99) {";
-        c += "P99[j] = value;";
-        c += "P99_done = true;";
-        c += "}";
-        c += "cum_count_prev = cum_count;";
-        c += "value_prev = value;";
-        c += "}";
-        c += "gini[j] = (2.0 * cum_value_i ) / (total_count * cum_value) - (total_count + 1.0) / total_count;";
-        c += "}";
-        c += "}";
-        c += "";
+        if (Symbol::option_quantile_sketch > 0) {
+            c += "// retained items of the quantile sketch in increasing order, with the number of observations each stands for";
+            c += "auto lst = coll[cell][j].sorted();";
+            c += "double total_count = (double)coll[cell][j].count();";
+            c += "if (total_count > 0) {";
+            c += "double cum_count = 0.0;";
+            c += "double cum_count_prev = 0.0;";
+            c += "double value_prev = 0.0;";
+            c += "double cum_value = 0.0;";
+            c += "double cum_value_i = 0.0; // sum of rank*value";
+            c += "bool P1_done = false;";
+            c += "bool P2_done = false;";
+            c += "bool P5_done = false;";
+            c += "bool P10_done = false;";
+            c += "bool P20_done = false;";
+            c += "bool P25_done = false;";
+            c += "bool P30_done = false;";
+            c += "bool P40_done = false;";
+            c += "bool P50_done = false;";
+            c += "bool P60_done = false;";
+            c += "bool P70_done = false;";
+            c += "bool P75_done = false;";
+            c += "bool P80_done = false;";
+            c += "bool P90_done = false;";
+            c += "bool P95_done = false;";
+            c += "bool P98_done = false;";
+            c += "bool P99_done = false;";
+            c += "for (auto &item : lst ) {";
+            c += "double value = item.first;";
+            c += "double weight = item.second;";
+            c += "// item occupies ranks cum_count + 1 to cum_count + weight";
+            c += "cum_value_i += value * (weight * cum_count + weight * (weight + 1.0) / 2.0);";
+            c += "cum_count += weight;";
+            c += "cum_value += weight * value;";
+            c += "if (!P1_done && cum_count >= total_count * 0.01) {";
+            c += "P1[j] = value;";
+            c += "P1_done = true;";
+            c += "}";
+            c += "if (!P2_done && cum_count >= total_count * 0.02) {";
+            c += "P2[j] = value;";
+            c += "P2_done = true;";
+            c += "}";
+            c += "if (!P5_done && cum_count >= total_count * 0.05) {";
+            c += "P5[j] = value;";
+            c += "P5_done = true;";
+            c += "}";
+            c += "if (!P10_done && cum_count >= total_count * 0.10) {";
+            c += "P10[j] = value;";
+            c += "P10_done = true;";
+            c += "}";
+            c += "if (!P20_done && cum_count >= total_count * 0.20) {";
+            c += "P20[j] = value;";
+            c += "P20_done = true;";
+            c += "}";
+            c += "if (!P25_done && cum_count >= total_count * 0.25) {";
+            c += "P25[j] = value;";
+            c += "P25_done = true;";
+            c += "}";
+            c += "if (!P30_done && cum_count >= total_count * 0.30) {";
+            c += "P30[j] = value;";
+            c += "P30_done = true;";
+            c += "}";
+            c += "if (!P40_done && cum_count >= total_count * 0.40) {";
+            c += "P40[j] = value;";
+            c += "P40_done = true;";
+            c += "}";
+            c += "if (!P50_done && cum_count >= total_count * 0.50) {";
+            c += "P50[j] = value;";
+            c += "P50_done = true;";
+            c += "}";
+            c += "if (!P60_done && cum_count >= total_count * 0.60) {";
+            c += "P60[j] = value;";
+            c += "P60_done = true;";
+            c += "}";
+            c += "if (!P70_done && cum_count >= total_count * 0.70) {";
+            c += "P70[j] = value;";
+            c += "P70_done = true;";
+            c += "}";
+            c += "if (!P75_done && cum_count >= total_count * 0.75) {";
+            c += "P75[j] = value;";
+            c += "P75_done = true;";
+            c += "}";
+            c += "if (!P80_done && cum_count >= total_count * 0.80) {";
+            c += "P80[j] = value;";
+            c += "P80_done = true;";
+            c += "}";
+            c += "if (!P90_done && cum_count >= total_count * 0.90) {";
+            c += "P90[j] = value;";
+            c += "P90_done = true;";
+            c += "}";
+            c += "if (!P95_done && cum_count >= total_count * 0.95) {";
+            c += "P95[j] = value;";
+            c += "P95_done = true;";
+            c += "}";
+            c += "if (!P98_done && cum_count >= total_count * 0.98) {";
+            c += "P98[j] = value;";
+            c += "P98_done = true;";
+            c += "}";
+            c += "if (!P99_done && cum_count >= total_count * 0.99) {";
+            c += "P99[j] = value;";
+            c += "P99_done = true;";
+            c += "}";
+            c += "cum_count_prev = cum_count;";
+            c += "value_prev = value;";
+            c += "}";
+            c += "gini[j] = (2.0 * cum_value_i ) / (total_count * cum_value) - (total_count + 1.0) / total_count;";
+            c += "}";
+            c += "}";
+        }
+        else {
+            c += "}";
+            c += "";
+            // The statistics required of each observation collection, in increasing order of percentile.
+            const std::vector<std::pair<token_type, std::string>> percentiles = {
+                { token::TK_P1, "0.01" }, { token::TK_P2, "0.02" }, { token::TK_P5, "0.05" },
+                { token::TK_P10, "0.10" }, { token::TK_P20, "0.20" }, { token::TK_P25, "0.25" },
+                { token::TK_P30, "0.30" }, { token::TK_P40, "0.40" }, { token::TK_P50, "0.50" },
+                { token::TK_P60, "0.60" }, { token::TK_P70, "0.70" }, { token::TK_P75, "0.75" },
+                { token::TK_P80, "0.80" }, { token::TK_P90, "0.90" }, { token::TK_P95, "0.95" },
+                { token::TK_P98, "0.98" }, { token::TK_P99, "0.99" },
+            };
+            for (int j = 0; j < n_collections; ++j) {
+                std::set<token_type> stats;
+                for (auto acc : pp_accumulators) {
+                    if (acc->has_obs_collection && acc->obs_collection_index == j) {
+                        stats.insert(acc->statistic);
+                    }
+                }
+                bool needs_sort = stats.count(token::TK_gini) > 0;
+                string obs_index = to_string(j);
+                c += "{";
+                c += "auto &obs = coll[cell][" + obs_index + "];";
+                c += "size_t n = obs.size();";
+                c += "if (n > 0) {";
+                if (needs_sort) {
+                    c += "// gini requires all observations in order";
+                    c += "std::sort(obs.begin(), obs.end());";
+                    for (auto& pct : percentiles) {
+                        if (stats.count(pct.first)) {
+                            string stat_name = token_to_string(pct.first);
+                            c += stat_name + "[" + obs_index + "] = obs[obs_collection_position(n, " + pct.second + ")];";
+                        }
+                    }
+                    c += "gini[" + obs_index + "] = obs_collection_gini(obs.data(), n);";
+                }
+                else {
+                    c += "// select required percentiles only, each selection narrowing the range of the next";
+                    c += "auto first = obs.begin();";
+                    for (auto& pct : percentiles) {
+                        if (stats.count(pct.first)) {
+                            string stat_name = token_to_string(pct.first);
+                            c += "{";
+                            c += "auto nth = obs.begin() + obs_collection_position(n, " + pct.second + ");";
+                            c += "std::nth_element(first, nth, obs.end());";
+                            c += stat_name + "[" + obs_index + "] = *nth;";
+                            c += "first = nth;";
+                            c += "}";
+                        }
+                    }
+                }
+                c += "}";
+                c += "}";
+            }
+            c += "";
+        }
     } // if (n_collections > 0)
 
     for (auto acc : pp_accumulators) {
@@ -694,8 +768,9 @@ CodeBlock EntityTableSymbol::cxx_definition_global()
                 assert(acc->extrema_collections_index >= 0);
                 c += "size_t es = " + to_string(screened_extremas_size()) + ";";
                 c += "const size_t extrema_index = " + to_string(acc->extrema_collections_index) + ";";
-                c += "const auto& smallest = extrema[cell][extrema_index].first;";
-                c += "const auto& largest = extrema[cell][extrema_index].second;";
+                c += "// sort the final extremas only";
+                c += "const auto smallest = extrema[cell][extrema_index].first.sorted();";
+                c += "const auto largest = extrema[cell][extrema_index].second.sorted();";
             }
             else {
                 // no extremas collections associated with this statistic
@@ -711,7 +786,17 @@ CodeBlock EntityTableSymbol::cxx_definition_global()
         c += "";
     }
 
-    c += "} // cell";
+    if (is_sparse) {
+        c += "}; // extract_cell";
+        c += "";
+        c += "// cells never touched are identical, extract one of them for the fill values";
+        c += "for_untouched_cells(extract_cell);";
+        c += "// process each cell in a page which was touched";
+        c += "for_each_touched_cell(extract_cell);";
+    }
+    else {
+        c += "} // cell";
+    }
     c += "}"; // extract_accumulators
     c += "";
 
@@ -732,8 +817,18 @@ CodeBlock EntityTableSymbol::cxx_definition_global()
                 assert(acc->pp_attribute);
                 c += "// " + Symbol::token_to_string(acc->statistic) + "(" + Symbol::token_to_string(acc->increment) + "(" + acc->pp_attribute->name + "))";
             }
-            // e.g. for ( int cell = 0; cell < n_cells; cell++ ) acc[0][cell] *= scale_factor;
-            c += "for (int cell = 0; cell < n_cells; cell++) acc[" + to_string(acc->index) + "][cell] *= scale_factor;";
+            if (is_sparse) {
+                // cells never touched are scaled through the fill value
+                c += "{";
+                c += "auto scale_cell = [&](int cell) { acc[" + to_string(acc->index) + "][cell] *= scale_factor; };";
+                c += "for_untouched_cells(scale_cell);";
+                c += "for_each_touched_cell(scale_cell);";
+                c += "}";
+            }
+            else {
+                // e.g. for ( int cell = 0; cell < n_cells; cell++ ) acc[0][cell] *= scale_factor;
+                c += "for (int cell = 0; cell < n_cells; cell++) acc[" + to_string(acc->index) + "][cell] *= scale_factor;";
+            }
         }
     }
     c += "}";
@@ -754,9 +849,20 @@ CodeBlock EntityTableSymbol::cxx_definition_global()
         if (measure->scale != 0) {
             scale_part = measure->scale_as_factor() + " * ";
         }
-        // E.g. for ( int cell = 0; cell < n_cells; cell++ ) measure[0][cell] = acc[0][cell] ;
-        c += "for (int cell = 0; cell < n_cells; cell++ ) "
-            "measure[" + to_string(etm->index) + "][cell] = " + scale_part + etm->get_expression(etm->root, EntityTableMeasureSymbol::expression_style::cxx) + " ;";
+        if (is_sparse) {
+            // measures of cells never touched are computed once, as the fill value
+            c += "{";
+            c += "auto compute_cell = [&](int cell) { "
+                "measure[" + to_string(etm->index) + "][cell] = " + scale_part + etm->get_expression(etm->root, EntityTableMeasureSymbol::expression_style::cxx) + " ; };";
+            c += "for_untouched_cells(compute_cell);";
+            c += "for_each_touched_cell(compute_cell);";
+            c += "}";
+        }
+        else {
+            // E.g. for ( int cell = 0; cell < n_cells; cell++ ) measure[0][cell] = acc[0][cell] ;
+            c += "for (int cell = 0; cell < n_cells; cell++ ) "
+                "measure[" + to_string(etm->index) + "][cell] = " + scale_part + etm->get_expression(etm->root, EntityTableMeasureSymbol::expression_style::cxx) + " ;";
+        }
         c += "";
     }
     c += "}";
@@ -1200,7 +1306,12 @@ void EntityTableSymbol::build_body_push_increment()
             c += "const int obs_index = " + to_string(acc->obs_collection_index) + "; // observation collection index";
             if (acc->updates_obs_collection) {
                 c += "auto& obs_coll = table->coll[cell][obs_index];";
-                c += "obs_coll.push_front(dIncrement);";
+                if (Symbol::option_quantile_sketch > 0) {
+                    c += "obs_coll.insert(dIncrement);";
+                }
+                else {
+                    c += "obs_coll.push_back(dIncrement);";
+                }
             }
             else {
                 c += "// Same increment already being pushed to same collection by another accumulator";
@@ -1218,27 +1329,9 @@ void EntityTableSymbol::build_body_push_increment()
                     c += "const size_t extremas_max_size = " + to_string(screened_extremas_size()) + ";";
                     c += "const size_t extremas_index = " + to_string(acc->extrema_collections_index) + "; // pair of extrema collections index";
                     c += "auto& pr = table->extrema[cell][extremas_index];";
-                    c += "{";
-                    c +=     "// smallest";
-                    c +=     "auto& smallest = pr.first;";
-                    c +=     "smallest.insert(dIncrement);";
-                    c +=     "if (smallest.size() > extremas_max_size) {";
-                    c +=         "// remove largest (last) element";
-                    c +=         "auto it = smallest.cend();";
-                    c +=         "--it;";
-                    c +=         "smallest.erase(it);";
-                    c +=     "}";
-                    c += "}";
-                    c += "{";
-                    c +=     "// largest";
-                    c +=     "auto& largest = pr.second;";
-                    c +=     "largest.insert(dIncrement);";
-                    c +=     "if (largest.size() > extremas_max_size) {";
-                    c +=         "// remove smallest (first) element";
-                    c +=         "auto it = largest.cbegin();";
-                    c +=         "largest.erase(it);";
-                    c +=     "}";
-                    c += "} // largest";
+                    c += "// each heap rejects the increment unless it is among the most extreme";
+                    c += "pr.first.insert(dIncrement, extremas_max_size); // smallest";
+                    c += "pr.second.insert(dIncrement, extremas_max_size); // largest";
                 }
                 else {
                     c += "// Same increment already being pushed to same pair of extrema collections by another accumulator";
@@ -68,6 +68,7 @@ public:
         , default_tabop(token::TK_interval)
         , is_untransformed(false)
         , screened_method(0)
+        , is_sparse(false)
         , resource_use_gfn(nullptr)
         , resource_use_reset_gfn(nullptr)
     {
@@ -325,6 +326,11 @@ public:
      */
     int screened_method;
 
+    /**
+     * True if cells of the table are allocated in pages on first touch (sparse table property).
+     */
+    bool is_sparse;
+
     /**
      * true if the table is weighted
      */
@@ -1036,7 +1036,9 @@ string ParameterSymbol::cxx_definition_cumrate()
             + storage_duration
             + "cumrate<" 
             + to_string(conditioning_size()) + ","
-            + to_string(distribution_size()) + "> "
+            + to_string(distribution_size())
+            + (option_cumrate_alias ? ", cumrate_alias_distribution<" + to_string(distribution_size()) + ">" : "")
+            + "> "
             + cumrate_name() + ";";
     }
     return result;
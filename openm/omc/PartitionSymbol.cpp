@@ -90,89 +90,70 @@ CodeBlock PartitionSymbol::cxx_declaration_global()
     h += "";
     h += doxygen("Partition: " + name);
 
-    // lower bounds of intervals in partition
-    h += "extern const std::array<real, " + to_string(pp_size()) + "> om_" + name + "_lower;";
-    // upper bounds of intervals in partition
-    h += "extern const std::array<real, " + to_string(pp_size()) + "> om_" + name + "_upper;";
-    // splitter map for partition
-    h += "extern const std::map<real, " + token_to_string(storage_type) + "> om_" + name + "_splitter;";
-
-    h += "extern const std::string om_name_" + name + ";";
-    h += doxygen_short("Partition {0..." + to_string(pp_size() - 1) + "}: " + label());
-    h += "typedef Partition<" + token_to_string(storage_type) + ", "
-        + to_string(pp_size()) + ", "
-        + "om_" + name + "_lower, "
-        + "om_" + name + "_upper, "
-        + "om_" + name + "_splitter, " 
-        + "&om_name_" + name
-        + "> "
-        + name + ";" ;
-    h += doxygen_short("C-type of " + name + " (" + exposed_type() + ")");
-    h += "typedef " + exposed_type() + " " + name + "_t; // For use in model code";
-
-    return h;
-}
-
-CodeBlock PartitionSymbol::cxx_definition_global()
-{
-    // Hook into the hierarchical calling chain
-    CodeBlock c = super::cxx_definition_global();
-
-    // Perform operations specific to this level in the Symbol hierarchy.
-
-    c += "";
-    c += doxygen_short(name);
-
     // Used below as argument to real_literal() to avoid compiler warnings if real is float
     bool real_is_float = RealSymbol::find()->is_float();
 
     int index;  // index of interval in partition
 
-    c += "// lower bounds of intervals in partition";
-    c += "const std::array<real, " + to_string(pp_size()) + "> om_" + name + "_lower = {";
+    // Bounds are compile-time constants, used by Partition::value_to_interval to select the lookup method
+    h += "// lower bounds of intervals in partition";
+    h += "inline constexpr std::array<real, " + to_string(pp_size()) + "> om_" + name + "_lower = {";
     index = 0;  // index of interval in partition
     for (auto enumerator : pp_enumerators) {
         if (index > 0) {
             auto pes = dynamic_cast<PartitionEnumeratorSymbol *>(enumerator);
             assert(pes); // grammar guarantee
-            c += real_literal(pes->lower_split_point, real_is_float) + ",";
+            h += real_literal(pes->lower_split_point, real_is_float) + ",";
         }
         else {
             // special case for upper limit of last partition interval
-            c += "-REAL_MAX,";
+            h += "-REAL_MAX,";
         }
         ++index;
     }
-    c += "};";
+    h += "};";
 
-    c += "// upper bounds of intervals in partition";
-    c += "const std::array<real, " + to_string(pp_size()) + "> om_" + name + "_upper = {";
+    h += "// upper bounds of intervals in partition";
+    h += "inline constexpr std::array<real, " + to_string(pp_size()) + "> om_" + name + "_upper = {";
     index = 0;
     for (auto enumerator : pp_enumerators) {
         if (index < ((int)pp_size() - 1)) {
             auto pes = dynamic_cast<PartitionEnumeratorSymbol *>(enumerator);
             assert(pes); // grammar guarantee
-            c += real_literal(pes->upper_split_point, real_is_float) + ",";
+            h += real_literal(pes->upper_split_point, real_is_float) + ",";
         }
         else {
             // special case for upper limit of last partition interval
-            c += "REAL_MAX";
+            h += "REAL_MAX";
         }
         ++index;
     }
-    c += "};";
+    h += "};";
 
-    c += "// splitter map for partition";
-    c += "const std::map<real, " + token_to_string(storage_type) + "> om_" + name + "_splitter = {";
-    index = 0;  // index of interval in partition
-    for (auto enumerator : pp_enumerators) {
-        auto pes = dynamic_cast<PartitionEnumeratorSymbol *>(enumerator);
-        assert(pes); // grammar guarantee
-        c += "{ " + real_literal(pes->upper_split_point, real_is_float) + ", " + to_string(index) + " }," ;
-        ++index;
-        if (index == ((int)pp_size() - 1)) break;
-    }
-    c += "};";
+    h += "extern const std::string om_name_" + name + ";";
+    h += doxygen_short("Partition {0..." + to_string(pp_size() - 1) + "}: " + label());
+    h += "typedef Partition<" + token_to_string(storage_type) + ", "
+        + to_string(pp_size()) + ", "
+        + "om_" + name + "_lower, "
+        + "om_" + name + "_upper, "
+        + "&om_name_" + name
+        + "> "
+        + name + ";" ;
+    h += doxygen_short("C-type of " + name + " (" + exposed_type() + ")");
+    h += "typedef " + exposed_type() + " " + name + "_t; // For use in model code";
+
+    return h;
+}
+
+CodeBlock PartitionSymbol::cxx_definition_global()
+{
+    // Hook into the hierarchical calling chain
+    CodeBlock c = super::cxx_definition_global();
+
+    // Perform operations specific to this level in the Symbol hierarchy.
+
+    c += "";
+    c += doxygen_short(name);
 
     c += "const std::string om_name_" + name + " = \"" + pretty_name() + "\";";
 
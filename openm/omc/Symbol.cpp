@@ -148,6 +148,8 @@ multimap<string, string> Symbol::function_body_identifiers;
 
 multimap<string, pair<string, string>> Symbol::function_body_pointers;
 
+map<string, map<string, Symbol::member_profile_info>> Symbol::member_profile;
+
 multimap<string, int> Symbol::function_rng_streams;
 
 multimap<string, int> Symbol::function_rng_normal_streams;
@@ -328,6 +330,7 @@ unordered_map<token_type, string, std::hash<int> > Symbol::token_string =
     { token::TK_undergone_exit, "undergone_exit" },
     { token::TK_undergone_transition, "undergone_transition" },
     { token::TK_unit, "unit" },
+    { token::TK_unordered, "unordered" },
     { token::TK_untransformed, "untransformed" },
     { token::TK_ushort, "ushort" },
     { token::TK_value_at_changes, "value_at_changes" },
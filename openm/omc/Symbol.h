@@ -1445,6 +1445,30 @@ public:
      */
     static multimap<string, pair<string, string>> function_body_pointers;
 
+    /**
+     * Entity member information from a run of the model built with member_profile = on.
+     */
+    struct member_profile_info {
+        /** true if accesses were counted for the member (attributes only) */
+        bool has_accesses;
+        /** number of accesses to the member */
+        double accesses;
+        /** offset of the member in the entity */
+        size_t offset;
+        /** size of the member */
+        size_t size;
+        /** alignment of the member */
+        size_t alignment;
+    };
+
+    /**
+     * Member profile read from the csv file given by the omc option Omc.MemberProfile.
+     * 
+     * An example entry might be "Person" ==> "age" ==> {true, 3000000, 56, 8, 8}.
+     * Empty if no profile was supplied.
+     */
+    static map<string, map<string, member_profile_info>> member_profile;
+
     /**
      * Map of member function qualified names to all rng streams used in the body of the function.
      *
@@ -1820,6 +1844,52 @@ public:
      */
     static bool option_resource_use;
 
+    /**
+     * Sampling interval for timing of event functions, from resource_use_timing in options statement.
+     * 
+     * One of every N calls of an event time function or implement function is timed.
+     * Zero if timing is off.
+     */
+    static size_t option_resource_use_timing;
+
+    /**
+     * true or false depending on member_profile value in options statement.
+     * 
+     * If true, accesses to attributes are counted and written with the layout of entity members
+     * to a csv file which omc can use to lay out entity members (Omc.MemberProfile).
+     */
+    static bool option_member_profile;
+
+    /**
+     * true or false depending on batched_aging value in options statement.
+     * 
+     * If true, age_all_entities ages entities one kind at a time, without virtual calls.
+     */
+    static bool option_batched_aging;
+
+    /**
+     * Capacity of quantile sketches for percentile and gini statistics, from quantile_sketch in options statement.
+     * 
+     * If non-zero, observation collections of entity tables are bounded-memory approximate sketches
+     * instead of lists of all observations.  Zero if quantile_sketch is off.
+     */
+    static size_t option_quantile_sketch;
+
+    /**
+     * true or false depending on cumrate_alias value in options statement.
+     * 
+     * If true, cumrate parameters are drawn in constant time from alias tables.
+     * Draws differ from the default cumulated probability search for the same uniform.
+     */
+    static bool option_cumrate_alias;
+
+    /**
+     * true if random_normal is ziggurat in options statement, false if polar (the default).
+     * 
+     * If true, RandNormal uses the ziggurat method with uniforms drawn in bulk from each stream.
+     */
+    static bool option_random_normal_ziggurat;
+
     /**
      * true or false depending on fp_exceptions value in options statement.
      */
@@ -1915,6 +1985,27 @@ public:
      */
     static bool option_censor_event_time;
 
+    /// Implementation of the event queue
+    enum class event_queue_method {
+
+        /// std::set ordered by event (default)
+        set,
+
+        /// 4-ary indexed heap with event position stored in the event
+        heap,
+
+        /// calendar queue with bucket width tuned from observed inter-event times
+        calendar,
+
+        /// binary heap with lazy removal of rescheduled events (tombstones)
+        lazy,
+    };
+
+    /**
+     * The implementation of the event queue, from event_queue value in options statement.
+     */
+    static event_queue_method option_event_queue;
+
     /**
      * true or false depending on ascii_infinity in options statement.
      */
@@ -39,6 +39,12 @@ bool Symbol::option_verify_valid_table_increment = true;
 bool Symbol::option_weighted_tabulation_allow_time_based = false;
 bool Symbol::option_weighted_tabulation = false;
 bool Symbol::option_resource_use = false;
+size_t Symbol::option_resource_use_timing = 0;
+bool Symbol::option_member_profile = false;
+bool Symbol::option_batched_aging = false;
+size_t Symbol::option_quantile_sketch = 0;
+bool Symbol::option_cumrate_alias = false;
+bool Symbol::option_random_normal_ziggurat = false;
 bool Symbol::option_fp_exceptions = false;
 bool Symbol::option_fp_exceptions_warning = true;
 bool Symbol::option_entity_member_packing = false;
@@ -58,6 +64,7 @@ size_t Symbol::option_screened3_extremas_size = 0;
 size_t Symbol::option_screened4_extremas_size = 0;
 size_t Symbol::short_name_max_length = 32;
 bool Symbol::option_censor_event_time = false;
+Symbol::event_queue_method Symbol::option_event_queue = event_queue_method::set;
 bool Symbol::option_ascii_infinity = false;
 bool Symbol::option_missing_label_warning_enumeration = false;
 bool Symbol::option_missing_label_warning_parameter = false;
@@ -536,6 +543,146 @@ void Symbol::do_options()
         }
     }
 
+    {
+        string key = "batched_aging";
+        auto iter = options.find(key);
+        if (iter != options.end()) {
+            auto& opt_pair = iter->second; // opt_pair is option value, option location
+            string& value = opt_pair.first;
+            if (value == "on") {
+                option_batched_aging = true;
+            }
+            else if (value == "off") {
+                option_batched_aging = false;
+            }
+            // remove processed option
+            options.erase(iter);
+        }
+    }
+
+    {
+        string key = "member_profile";
+        auto iter = options.find(key);
+        if (iter != options.end()) {
+            auto& opt_pair = iter->second; // opt_pair is option value, option location
+            string& value = opt_pair.first;
+            if (value == "on") {
+                option_member_profile = true;
+            }
+            else if (value == "off") {
+                option_member_profile = false;
+            }
+            // remove processed option
+            options.erase(iter);
+        }
+    }
+
+    {
+        string key = "resource_use_timing";
+        auto iter = options.find(key);
+        if (iter != options.end()) {
+            auto& opt_pair = iter->second; // opt_pair is option value, option location
+            string& value = opt_pair.first;
+            auto& loc = opt_pair.second;
+            if (value == "off") {
+                option_resource_use_timing = 0;
+            }
+            else {
+                int ivalue = 0;
+                try {
+                    ivalue = stoi(value);
+                }
+                catch (...) {
+                    ivalue = -1;
+                }
+                if (ivalue >= 0) {
+                    option_resource_use_timing = (size_t)ivalue;
+                }
+                else {
+                    pp_error(loc, LT("error : '") + value + LT("' is invalid - resource_use_timing must be off or a non-negative sampling interval"));
+                }
+            }
+            if (option_resource_use_timing > 0 && !option_resource_use) {
+                // timing of event functions is part of resource use (option resource_use is processed above)
+                post_parse_warnings++;
+                pp_logmsg(loc, LT("warning : resource_use_timing is ignored because resource_use is off"));
+            }
+            // remove processed option
+            options.erase(iter);
+        }
+    }
+
+    {
+        string key = "quantile_sketch";
+        auto iter = options.find(key);
+        if (iter != options.end()) {
+            auto& opt_pair = iter->second; // opt_pair is option value, option location
+            string& value = opt_pair.first;
+            auto& loc = opt_pair.second;
+            if (value == "off") {
+                option_quantile_sketch = 0;
+            }
+            else if (value == "on") {
+                option_quantile_sketch = 200;
+            }
+            else {
+                int ivalue = 0;
+                try {
+                    ivalue = stoi(value);
+                }
+                catch (...) {
+                    ivalue = -1;
+                }
+                if (ivalue >= 8) {
+                    option_quantile_sketch = (size_t)ivalue;
+                }
+                else {
+                    pp_error(loc, LT("error : '") + value + LT("' is invalid - quantile_sketch must be on, off, or a capacity of at least 8"));
+                }
+            }
+            // remove processed option
+            options.erase(iter);
+        }
+    }
+
+    {
+        string key = "cumrate_alias";
+        auto iter = options.find(key);
+        if (iter != options.end()) {
+            auto& opt_pair = iter->second; // opt_pair is option value, option location
+            string& value = opt_pair.first;
+            if (value == "on") {
+                option_cumrate_alias = true;
+            }
+            else if (value == "off") {
+                option_cumrate_alias = false;
+            }
+            // remove processed option
+            options.erase(iter);
+        }
+    }
+
+    {
+        string key = "random_normal";
+        auto iter = options.find(key);
+        if (iter != options.end()) {
+            auto& opt_pair = iter->second; // opt_pair is option value, option location
+            string& value = opt_pair.first;
+            auto& loc = opt_pair.second;
+            if (value == "polar") {
+                option_random_normal_ziggurat = false;
+            }
+            else if (value == "ziggurat") {
+                option_random_normal_ziggurat = true;
+            }
+            else {
+                pp_error(loc, LT("error : '") + value + LT("' is invalid - random_normal must be polar or ziggurat"));
+            }
+            // remove processed option
+            options.erase(iter);
+        }
+    }
+
     {
         string key = "fp_exceptions";
         auto iter = options.find(key);
@@ -725,6 +872,33 @@ void Symbol::do_options()
         }
     }
 
+    {
+        string key = "event_queue";
+        auto iter = options.find(key);
+        if (iter != options.end()) {
+            auto& opt_pair = iter->second; // opt_pair is option value, option location
+            string& value = opt_pair.first;
+            auto& loc = opt_pair.second;
+            if (value == "set") {
+                option_event_queue = event_queue_method::set;
+            }
+            else if (value == "heap") {
+                option_event_queue = event_queue_method::heap;
+            }
+            else if (value == "calendar") {
+                option_event_queue = event_queue_method::calendar;
+            }
+            else if (value == "lazy") {
+                option_event_queue = event_queue_method::lazy;
+            }
+            else {
+                pp_error(loc, LT("error : '") + value + LT("' is invalid - event_queue must be set, heap, calendar, or lazy"));
+            }
+            // remove processed option
+            options.erase(iter);
+        }
+    }
+
     {
         string key = "ascii_infinity";
         auto iter = options.find(key);
@@ -145,6 +145,9 @@ namespace openm
 
         /** list of functions which produce localized messages */
         static constexpr const char * messageFnc = "Omc.MessageFnc";
+
+        /** omc input csv file with entity member profile, written by a model run with member_profile = on */
+        static constexpr const char * memberProfile = "Omc.MemberProfile";
     };
 
     /** keys for omc options (short form) */
@@ -200,6 +203,7 @@ namespace openm
         OmcArgKey::dbProviderNames,
         OmcArgKey::messageLang,
         OmcArgKey::messageFnc,
+        OmcArgKey::memberProfile,
         ArgKey::iniFile,
         ArgKey::logToConsole,
         ArgKey::logToFile,
@@ -232,6 +236,7 @@ static bool parseBoolOption(const char * i_key, const ArgReader & i_argStore);
 static void parseFiles(list<string> & files, const list<string>::iterator start_it, ParseContext & pc, ofstream *markup_stream);
 static void processExtraParamDir(const string & i_paramDir, const string & i_scenarioName, const MetaModelHolder & i_metaRows, IModelBuilder * i_builder);
 static void createWorkset(const MetaModelHolder & i_metaRows, MetaSetLangHolder & io_metaSet, IModelBuilder * i_builder);
+static void readMemberProfile(const string & i_path);
 
 int main(int argc, char * argv[])
 {
@@ -556,6 +561,11 @@ int main(int argc, char * argv[])
             if (Symbol::post_parse_errors == 0) Symbol::post_parse_errors = 1;
         }
 
+        // load entity member profile to lay out entity members
+        if (argStore.isOptionExist(OmcArgKey::memberProfile)) {
+            readMemberProfile(argStore.strOption(OmcArgKey::memberProfile));
+        }
+
         // load parameters data from .csv or .tsv files
         forward_list<unique_ptr<Constant> > cpLst;
 
@@ -987,6 +997,44 @@ static void parseFiles(list<string> & files, const list<string>::iterator start_
     }
 }
 
+// read entity member profile from csv file written by a model run with member_profile = on
+// each line is: entity,member,accesses,offset,size,alignment
+// accesses is empty if not counted for the member
+static void readMemberProfile(const string & i_path)
+{
+    ifstream csv(i_path);
+    if (!csv.is_open()) throw HelperException(LT("error : unable to open member profile %s"), i_path.c_str());
+
+    theLog->logFormatted("Entity member profile from: %s", i_path.c_str());
+    string line;
+    getline(csv, line); // skip header line
+    int line_num = 1;
+    while (getline(csv, line)) {
+        line_num++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+
+        vector<string> cols;
+        for (auto & col : splitCsv(line, ",", false)) {
+            cols.push_back(col);
+        }
+        if (cols.size() != 6) throw HelperException(LT("error : invalid line %d in member profile %s"), line_num, i_path.c_str());
+
+        Symbol::member_profile_info info;
+        try {
+            info.has_accesses = !cols[2].empty();
+            info.accesses = info.has_accesses ? stod(cols[2]) : 0.0;
+            info.offset = stoul(cols[3]);
+            info.size = stoul(cols[4]);
+            info.alignment = stoul(cols[5]);
+        }
+        catch (...) {
+            throw HelperException(LT("error : invalid line %d in member profile %s"), line_num, i_path.c_str());
+        }
+        Symbol::member_profile[cols[0]][cols[1]] = info;
+    }
+}
+
 // process extra parameter directory: 
 // if any parameter csv files exist then read it and create additional (not default) workset in model database
 static void processExtraParamDir(const string & i_paramDir, const string & i_scenarioName, const MetaModelHolder & i_metaRows, IModelBuilder * i_builder)
@@ -282,6 +282,7 @@ static bool check_undeclared(Symbol* sym, const yy::parser::location_type& loc,
 %token <val_token>    TK_undergone_exit            "undergone_exit"
 %token <val_token>    TK_undergone_transition      "undergone_transition"
 %token <val_token>    TK_unit                      "unit"
+%token <val_token>    TK_unordered                 "unordered"
 %token <val_token>    TK_untransformed             "untransformed"
 %token <val_token>    TK_ushort                    "ushort"
 %token <val_token>    TK_value_at_changes          "value_at_changes"
@@ -2450,6 +2451,12 @@ entity_set_order_opt:
                             // note order attribute in entity set
                             entity_set->order = order->stable_pp();
                         }
+    | "unordered"
+                        {
+                            EntitySetSymbol *entity_set = pc.get_entity_set_context();
+                            // entities are stored in no particular order, for O(1) insert, erase, and random access
+                            entity_set->set_unordered();
+                        }
     | /* nothing */
     ;
 /*
@@ -2528,6 +2535,13 @@ decl_table: // Some code for decl_entity_set and decl_table is nearly identical
                                         table->screened_method = 0; // means table is not screened
                                     }
                                 }
+                                {
+                                    // handle sparse
+                                    bool sparse = $properties->count(token::TK_sparse) > 0;
+                                    if (sparse) {
+                                        table->is_sparse = true;
+                                    }
+                                }
                                 $properties->clear();
                                 delete $properties;
                             }
@@ -2582,6 +2596,7 @@ table_property:
     | "screened2"
     | "screened3"
     | "screened4"
+    | "sparse"
 	;
 
 